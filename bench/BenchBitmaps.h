@@ -0,0 +1,81 @@
+#pragma once
+
+#include "framework.h"
+
+#include "ComLibraryGuard.h"
+#include "HResultError.h"
+#include "SoftwareRasterizer.h"	//SoftwareBitmap
+
+//real d2d bitmaps for the benches that go through DrawList and
+//SoftwarePainter, which key everything on the bitmap pointer
+//made on a wic bitmap render target, so no window or gpu is needed
+namespace wasp::bench {
+	using win32adaptor::HResultError;
+
+	class BenchBitmaps {
+	private:
+		//declared first so com is uninitialized after everything is released
+		win32adaptor::ComLibraryGuard comLibraryGuard{};
+		CComPtr<ID2D1Factory> d2dFactoryPointer{};
+		CComPtr<IWICImagingFactory> wicFactoryPointer{};
+		CComPtr<IWICBitmap> targetBitmapPointer{};
+		CComPtr<ID2D1RenderTarget> renderTargetPointer{};
+
+	public:
+		BenchBitmaps() {
+			//multithreaded, the benches hand bitmaps to other threads
+			comLibraryGuard.init(COINIT_MULTITHREADED);
+			if (FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &d2dFactoryPointer))) {
+				throw HResultError{ "Error creating Direct2D factory" };
+			}
+			if (FAILED(CoCreateInstance(
+				CLSID_WICImagingFactory,
+				NULL,
+				CLSCTX_INPROC_SERVER,
+				IID_PPV_ARGS(&wicFactoryPointer)
+			))) {
+				throw HResultError{ "Error creating WIC imaging factory" };
+			}
+			if (FAILED(wicFactoryPointer->CreateBitmap(
+				1,
+				1,
+				GUID_WICPixelFormat32bppPBGRA,
+				WICBitmapCacheOnLoad,
+				&targetBitmapPointer
+			))) {
+				throw HResultError{ "Error creating WIC bitmap" };
+			}
+			if (FAILED(d2dFactoryPointer->CreateWicBitmapRenderTarget(
+				targetBitmapPointer,
+				D2D1::RenderTargetProperties(
+					D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+					D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+				),
+				&renderTargetPointer
+			))) {
+				throw HResultError{ "Error creating WIC bitmap render target" };
+			}
+		}
+
+		BenchBitmaps(const BenchBitmaps& other) = delete;
+		void operator=(const BenchBitmaps& other) = delete;
+
+		CComPtr<ID2D1Bitmap> makeBitmap(const graphics::SoftwareBitmap& softwareBitmap) {
+			CComPtr<ID2D1Bitmap> bitmapPointer{};
+			HRESULT result{ renderTargetPointer->CreateBitmap(
+				D2D1::SizeU(softwareBitmap.width, softwareBitmap.height),
+				softwareBitmap.pixels.data(),
+				softwareBitmap.width * 4,	//pitch
+				D2D1::BitmapProperties(D2D1::PixelFormat(
+					DXGI_FORMAT_B8G8R8A8_UNORM,
+					D2D1_ALPHA_MODE_PREMULTIPLIED
+				)),
+				&bitmapPointer
+			) };
+			if (FAILED(result)) {
+				throw HResultError{ "Error creating bitmap from pixels" };
+			}
+			return bitmapPointer;
+		}
+	};
+}
\ No newline at end of file
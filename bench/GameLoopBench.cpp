@@ -0,0 +1,109 @@
+#include "GameLoop.h"
+
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+//per iteration overhead of the game loop itself, with callables that do
+//next to nothing
+//runHeadless on a virtual clock isolates the cost of calling through the
+//loop, type erased against lambda typed; uncapped run() on the real clock
+//adds the clock reads and frame bookkeeping a real frame pays
+
+namespace {
+	using namespace wasp::game::gameloop;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int updatesPerSecond{ 100 };
+	constexpr int maxUpdatesWithoutFrame{ 5 };
+	constexpr uint64_t headlessUpdates{ 10'000'000 };
+	constexpr uint64_t uncappedFrames{ 2'000'000 };
+	constexpr int runs{ 5 };
+
+	//touched by every call so the callables can't be optimized away
+	volatile uint64_t updateCount{};
+	volatile uint64_t drawCount{};
+
+	template <typename Loop>
+	double timeHeadlessNanosecondsPerTick(Loop& loop) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			const HeadlessRunResult result{ loop.runHeadless(headlessUpdates, 1) };
+			const double nanoseconds{
+				std::chrono::duration<double, std::nano>{ result.wallTime }.count()
+			};
+			best = std::min(best, nanoseconds / static_cast<double>(result.updates));
+		}
+		return best;
+	}
+
+	//the draw function stops the loop once it has drawn enough frames
+	template <typename Loop>
+	double timeUncappedNanosecondsPerFrame(Loop& loop) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			drawCount = 0;
+			const clockType::time_point start{ clockType::now() };
+			loop.run();
+			const double nanoseconds{
+				std::chrono::duration<double, std::nano>{ clockType::now() - start }.count()
+			};
+			best = std::min(best, nanoseconds / static_cast<double>(drawCount));
+		}
+		return best;
+	}
+}
+
+int main() {
+	const auto update{ [] { updateCount = updateCount + 1; } };
+	const auto headlessDraw{ [](double) { drawCount = drawCount + 1; } };
+
+	HeadlessGameLoop typeErasedHeadless{
+		updatesPerSecond,
+		maxUpdatesWithoutFrame,
+		0,
+		update,
+		headlessDraw
+	};
+	auto templatedHeadless{ makeGameLoop<VirtualClock>(
+		updatesPerSecond,
+		maxUpdatesWithoutFrame,
+		0,
+		update,
+		headlessDraw
+	) };
+	std::cout << "runHeadless, update and draw every tick (ns per tick)\n";
+	std::cout << "  type erased  " << timeHeadlessNanosecondsPerTick(typeErasedHeadless) << "\n";
+	std::cout << "  lambda typed " << timeHeadlessNanosecondsPerTick(templatedHeadless) << "\n";
+
+	//the loops are built before the draw functions can name them, so they stop
+	//whichever loop is running through this
+	std::function<void()> stopRunningLoop{};
+	const auto uncappedDraw{ [&](double) {
+		drawCount = drawCount + 1;
+		if (drawCount >= uncappedFrames) {
+			stopRunningLoop();
+		}
+	} };
+
+	GameLoop typeErasedUncapped{
+		updatesPerSecond,
+		maxUpdatesWithoutFrame,
+		0,
+		update,
+		uncappedDraw
+	};
+	BasicGameLoop templatedUncapped{
+		updatesPerSecond,
+		maxUpdatesWithoutFrame,
+		0,
+		update,
+		uncappedDraw
+	};
+	std::cout << "uncapped run() on steady_clock (ns per frame)\n";
+	stopRunningLoop = [&] { typeErasedUncapped.stop(); };
+	std::cout << "  type erased  " << timeUncappedNanosecondsPerFrame(typeErasedUncapped) << "\n";
+	stopRunningLoop = [&] { templatedUncapped.stop(); };
+	std::cout << "  lambda typed " << timeUncappedNanosecondsPerFrame(templatedUncapped) << "\n";
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "JobSystem.h"
+
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+
+//how parallelFor scales from 1 thread up to one per core, on a bullet
+//update shaped like the game's, then the cost of an empty job
+//pass a thread count to go past the core count
+//single core machines only get the 1 thread line, run this on the real thing
+
+namespace {
+	using namespace wasp::jobs;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr std::size_t bulletCount{ 200'000 };
+	constexpr std::size_t grainSize{ 4096 };
+	constexpr int frames{ 50 };
+	constexpr int runs{ 5 };
+	constexpr int emptyJobs{ 100'000 };
+
+	struct Bullet {
+		float x{};
+		float y{};
+		float velocityX{};
+		float velocityY{};
+	};
+
+	//read at the end so the updates can't be optimized out
+	volatile float sink{};
+
+	void updateBullets(std::vector<Bullet>& bullets, std::size_t begin, std::size_t end) {
+		for (std::size_t i{ begin }; i < end; ++i) {
+			Bullet& bullet{ bullets[i] };
+			bullet.x += bullet.velocityX;
+			bullet.y += bullet.velocityY;
+			bullet.velocityX = std::sin(bullet.y) * 0.5f;
+			bullet.velocityY = std::cos(bullet.x) * 0.5f;
+		}
+	}
+
+	//best of several runs
+	double timeMillisecondsPerFrame(JobSystem& jobSystem, std::vector<Bullet>& bullets) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			const clockType::time_point start{ clockType::now() };
+			for (int frame{ 0 }; frame < frames; ++frame) {
+				jobSystem.parallelFor(0, bullets.size(), grainSize, [&](std::size_t begin, std::size_t end) {
+					updateBullets(bullets, begin, end);
+				});
+			}
+			const double milliseconds{
+				std::chrono::duration<double, std::milli>{ clockType::now() - start }.count()
+			};
+			best = std::min(best, milliseconds / frames);
+		}
+		return best;
+	}
+
+	void benchEmptyJobs() {
+		JobSystem jobSystem{};
+		JobCounter counter{};
+		const clockType::time_point start{ clockType::now() };
+		for (int i{ 0 }; i < emptyJobs; ++i) {
+			jobSystem.run(counter, [] {});
+		}
+		jobSystem.wait(counter);
+		const double nanoseconds{
+			std::chrono::duration<double, std::nano>{ clockType::now() - start }.count()
+		};
+		std::cout << "empty job with " << jobSystem.getThreadCount() << " threads: "
+			<< nanoseconds / emptyJobs << " ns\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	std::size_t maxThreads{ JobSystem::getDefaultWorkerCount() + 1 };
+	if (argc > 1) {
+		maxThreads = std::max(std::strtoul(argv[1], nullptr, 10), 1ul);
+	}
+
+	std::vector<Bullet> bullets(bulletCount);
+	for (std::size_t i{ 0 }; i < bullets.size(); ++i) {
+		bullets[i] = { static_cast<float>(i), 0.0f, 1.0f, 0.5f };
+	}
+
+	std::cout << bulletCount << " bullets, grain " << grainSize << "\n";
+	double oneThreadMilliseconds{};
+	for (std::size_t threads{ 1 }; threads <= maxThreads; ++threads) {
+		JobSystem jobSystem{ threads - 1 };
+		const double milliseconds{ timeMillisecondsPerFrame(jobSystem, bullets) };
+		if (threads == 1) {
+			oneThreadMilliseconds = milliseconds;
+		}
+		const double speedup{ oneThreadMilliseconds / milliseconds };
+		std::cout << "threads " << threads << ": " << milliseconds << " ms per frame, speedup "
+			<< speedup << ", efficiency " << speedup / threads << "\n";
+	}
+	sink = bullets[bulletCount / 2].x;
+
+	benchEmptyJobs();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "PixelKernels.h"
+#include "SoftwareRasterizer.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+//nanoseconds per pixel for each kernel on each instruction set the cpu
+//supports, then a full frame of rotated sprites through the rasterizer
+//best of several runs, so other load on the machine mostly drops out
+
+namespace {
+	using namespace wasp::graphics;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr std::size_t spanLength{ 1024 };
+	constexpr int runs{ 50 };
+	constexpr int repeatsPerRun{ 20 };
+
+	std::mt19937 random{ 12345 };
+
+	//read after every run so the kernels can't be optimized out
+	volatile uint32_t sink{};
+
+	uint32_t randomPremultiplied() {
+		const uint32_t alpha{ static_cast<uint32_t>(random() & 0xFFu) };
+		uint32_t toRet{ alpha << 24 };
+		for (int channel{ 0 }; channel < 3; ++channel) {
+			toRet |= (alpha == 0 ? 0u : static_cast<uint32_t>(random() % (alpha + 1))) << (channel * 8);
+		}
+		return toRet;
+	}
+
+	template <typename Function>
+	double timeNanosecondsPerPixel(const std::vector<uint32_t>& output, Function function) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			const clockType::time_point start{ clockType::now() };
+			for (int repeat{ 0 }; repeat < repeatsPerRun; ++repeat) {
+				function();
+			}
+			const double nanoseconds{
+				std::chrono::duration<double, std::nano>{ clockType::now() - start }.count()
+			};
+			best = std::min(best, nanoseconds / (repeatsPerRun * static_cast<double>(spanLength)));
+			sink = output[run % output.size()];
+		}
+		return best;
+	}
+
+	void benchKernels(pixel::InstructionSet instructionSet) {
+		const pixel::Kernels& kernels{ pixel::getKernels(instructionSet) };
+
+		std::vector<uint32_t> source(spanLength);
+		std::vector<uint32_t> destination(spanLength);
+		std::generate(source.begin(), source.end(), randomPremultiplied);
+		std::generate(destination.begin(), destination.end(), randomPremultiplied);
+
+		constexpr int imageSize{ 512 };
+		std::vector<uint32_t> image(imageSize * imageSize);
+		std::generate(image.begin(), image.end(), randomPremultiplied);
+		const pixel::SourceImage sourceImage{ image.data(), imageSize, 0, 0, imageSize, imageSize };
+		//a slight rotation and shrink, the usual sprite case
+		const pixel::AffineSpan span{
+			pixel::toFixed(10.3f),
+			pixel::toFixed(20.7f),
+			pixel::toFixed(0.43f),
+			pixel::toFixed(0.25f)
+		};
+
+		std::cout << pixel::getName(instructionSet) << " (ns per pixel)\n";
+		std::cout << "  fill           " << timeNanosecondsPerPixel(destination, [&] {
+			kernels.fill(destination.data(), spanLength, 0x80808080u);
+		}) << "\n";
+		std::cout << "  modulate       " << timeNanosecondsPerPixel(destination, [&] {
+			kernels.modulate(destination.data(), source.data(), spanLength, 200);
+		}) << "\n";
+		std::cout << "  blend          " << timeNanosecondsPerPixel(destination, [&] {
+			kernels.blend(destination.data(), source.data(), spanLength);
+		}) << "\n";
+		std::cout << "  sampleNearest  " << timeNanosecondsPerPixel(destination, [&] {
+			kernels.sampleNearest(destination.data(), spanLength, sourceImage, span);
+		}) << "\n";
+		std::cout << "  sampleBilinear " << timeNanosecondsPerPixel(destination, [&] {
+			kernels.sampleBilinear(destination.data(), spanLength, sourceImage, span);
+		}) << "\n";
+	}
+
+	//uses the best kernels, same as the game does
+	void benchRasterizer() {
+		constexpr int frames{ 60 };
+		constexpr int spritesPerFrame{ 500 };
+
+		SoftwareBitmap bitmap{ 64, 64 };
+		bitmap.pixels.resize(bitmap.width * bitmap.height);
+		std::generate(bitmap.pixels.begin(), bitmap.pixels.end(), randomPremultiplied);
+
+		SoftwareRasterizer rasterizer{ 640, 480 };
+		const clockType::time_point start{ clockType::now() };
+		for (int frame{ 0 }; frame < frames; ++frame) {
+			rasterizer.clear(0xFF000000u);
+			for (int sprite{ 0 }; sprite < spritesPerFrame; ++sprite) {
+				rasterizer.drawBitmap(
+					bitmap,
+					{ static_cast<float>(random() % 640), static_cast<float>(random() % 480) },
+					{ 0.0f, 0.0f, 64.0f, 64.0f },
+					static_cast<float>(random() % 360),
+					1.0f,
+					0.75f
+				);
+			}
+			sink = rasterizer.getPixels()[frame];
+		}
+		const double milliseconds{
+			std::chrono::duration<double, std::milli>{ clockType::now() - start }.count()
+		};
+		std::cout << "rasterizer " << spritesPerFrame << " rotated sprites: "
+			<< milliseconds / frames << " ms per frame\n";
+	}
+}
+
+int main() {
+	for (pixel::InstructionSet instructionSet : {
+		pixel::InstructionSet::scalar,
+		pixel::InstructionSet::sse2,
+		pixel::InstructionSet::avx2
+	}) {
+		if (pixel::isSupported(instructionSet)) {
+			benchKernels(instructionSet);
+		}
+	}
+	benchRasterizer();
+	return 0;
+}
\ No newline at end of file
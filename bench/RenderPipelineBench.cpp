@@ -0,0 +1,317 @@
+#include "BenchBitmaps.h"
+#include "DrawList.h"
+#include "SoftwarePainter.h"
+#include "TripleBuffer.h"
+#include "Config.h"
+
+#include <array>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+//the update thread records each frame into a DrawList and hands it to
+//another thread that replays it into a SoftwarePainter, two ways:
+//a persistent render thread fed through a TripleBuffer and woken by a
+//condition variable, as RenderThread does, against spawning and detaching a
+//thread per frame and skipping frames while one is still going, as the draw
+//callback used to
+//the update thread submits at a fixed rate, waiting by yielding so it works
+//on a single core too
+//reports what the hand-off costs the update thread, how many frames got
+//rendered, and how long after its submit a frame finished rendering
+
+namespace {
+	using namespace wasp;
+	using namespace wasp::graphics;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int sheetSize{ 64 };
+	constexpr int spriteSize{ 16 };
+	constexpr int spriteCount{ 300 };
+	constexpr int frames{ 300 };
+	constexpr std::chrono::microseconds frameInterval{ 2000 };
+	constexpr int runs{ 3 };
+
+	std::mt19937 random{ 12345 };
+
+	int randomInt(int min, int max) {
+		return std::uniform_int_distribution<int>{ min, max }(random);
+	}
+
+	struct Frame {
+		DrawList drawList{};
+		clockType::time_point submitTime{};
+	};
+
+	//submit to rendered, summed over the rendered frames
+	class LatencyCounter {
+	private:
+		std::atomic<uint64_t> framesRendered{ 0 };
+		std::atomic<int64_t> totalNanoseconds{ 0 };
+
+	public:
+		void recordRendered(const Frame& frame) {
+			totalNanoseconds.fetch_add(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+					clockType::now() - frame.submitTime
+				).count(),
+				std::memory_order_relaxed
+			);
+			framesRendered.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		uint64_t getFramesRendered() const {
+			return framesRendered.load(std::memory_order_relaxed);
+		}
+
+		double getAverageMicroseconds() const {
+			const uint64_t rendered{ getFramesRendered() };
+			if (rendered == 0) {
+				return 0.0;
+			}
+			return totalNanoseconds.load(std::memory_order_relaxed) / 1000.0 / rendered;
+		}
+	};
+
+	void renderFrame(SoftwarePainter& painter, const Frame& frame) {
+		painter.beginDraw();
+		frame.drawList.replay(painter, painter);
+		painter.endDraw();
+	}
+
+	//the render thread loop of RenderThread, drawing into a SoftwarePainter
+	//and with nothing to present
+	class PersistentRenderer {
+	private:
+		SoftwarePainter& painter;
+		utility::TripleBuffer<Frame> frameBuffers{};
+
+		std::thread thread{};
+		std::mutex wakeMutex{};
+		std::condition_variable wakeCondition{};
+		bool frameSubmitted{};
+		bool stopRequested{};
+
+		LatencyCounter latencyCounter{};
+
+	public:
+		PersistentRenderer(SoftwarePainter& painter)
+			: painter{ painter } {
+			thread = std::thread{ [&] { renderLoop(); } };
+		}
+
+		PersistentRenderer(const PersistentRenderer& other) = delete;
+		void operator=(const PersistentRenderer& other) = delete;
+
+		Frame& getFrame() {
+			return frameBuffers.getWriteBuffer();
+		}
+
+		void submit() {
+			frameBuffers.publish();
+			{
+				std::lock_guard<std::mutex> lock{ wakeMutex };
+				frameSubmitted = true;
+			}
+			wakeCondition.notify_one();
+		}
+
+		//renders the last frame submitted, if it hasn't been yet
+		void finish() {
+			{
+				std::lock_guard<std::mutex> lock{ wakeMutex };
+				stopRequested = true;
+			}
+			wakeCondition.notify_one();
+			thread.join();
+		}
+
+		const LatencyCounter& getLatencyCounter() const {
+			return latencyCounter;
+		}
+
+	private:
+		void renderLoop() {
+			std::unique_lock<std::mutex> lock{ wakeMutex };
+			while (true) {
+				wakeCondition.wait(lock, [&] { return frameSubmitted || stopRequested; });
+				if (stopRequested && !frameSubmitted) {
+					return;
+				}
+				frameSubmitted = false;
+				lock.unlock();
+
+				if (frameBuffers.acquire()) {
+					renderFrame(painter, frameBuffers.getReadBuffer());
+					latencyCounter.recordRendered(frameBuffers.getReadBuffer());
+				}
+
+				lock.lock();
+			}
+		}
+	};
+
+	//a new detached thread per frame; one frame is recorded while the other
+	//is being rendered
+	class ThreadPerFrameRenderer {
+	private:
+		SoftwarePainter& painter;
+		std::array<Frame, 2> frameBuffers{};
+		std::size_t recordIndex{ 0 };
+		std::atomic_bool rendering{ false };
+		LatencyCounter latencyCounter{};
+
+	public:
+		ThreadPerFrameRenderer(SoftwarePainter& painter)
+			: painter{ painter } {
+		}
+
+		ThreadPerFrameRenderer(const ThreadPerFrameRenderer& other) = delete;
+		void operator=(const ThreadPerFrameRenderer& other) = delete;
+
+		Frame& getFrame() {
+			return frameBuffers[recordIndex];
+		}
+
+		void submit() {
+			//the frame is dropped while the last one is still going, and the
+			//next one is recorded into the same list
+			if (rendering.load(std::memory_order_acquire)) {
+				return;
+			}
+			rendering.store(true, std::memory_order_relaxed);
+			const Frame* frame{ &frameBuffers[recordIndex] };
+			recordIndex ^= 1;
+			std::thread{ [this, frame] {
+				renderFrame(painter, *frame);
+				latencyCounter.recordRendered(*frame);
+				rendering.store(false, std::memory_order_release);
+			} }.detach();
+		}
+
+		void finish() {
+			while (rendering.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+		}
+
+		const LatencyCounter& getLatencyCounter() const {
+			return latencyCounter;
+		}
+	};
+
+	struct Scene {
+		CComPtr<ID2D1Bitmap> sheet{};
+		std::vector<SpriteInstance> instances{};
+	};
+
+	//sprites drift a pixel a frame so every frame is a little different
+	void recordFrame(DrawList& drawList, const Scene& scene, int frame) {
+		drawList.beginDraw();
+		for (const SpriteInstance& instance : scene.instances) {
+			SpriteInstance moved{ instance };
+			moved.center.x = static_cast<float>(
+				(static_cast<int>(instance.center.x) + frame) % config::graphicsWidth
+			);
+			drawList.drawSubBitmap(
+				moved.center,
+				BitmapDrawInstruction{ scene.sheet },
+				moved.sourceRectangle
+			);
+		}
+		drawList.setLayer(1);
+		drawList.drawText({ 2.0f, 2.0f }, L"frame " + std::to_wstring(frame), { 200.0f, 20.0f });
+		drawList.endDraw();
+	}
+
+	struct PipelineResult {
+		double handOffMicroseconds{ 1e30 };
+		uint64_t framesRendered{};
+		double latencyMicroseconds{};
+	};
+
+	//keeps the run with the cheapest hand-off
+	template <typename Renderer>
+	PipelineResult timePipeline(SoftwarePainter& painter, const Scene& scene) {
+		PipelineResult best{};
+		for (int run{ 0 }; run < runs; ++run) {
+			Renderer renderer{ painter };
+			clockType::duration handOff{};
+			clockType::time_point nextFrame{ clockType::now() };
+			for (int frameIndex{ 0 }; frameIndex < frames; ++frameIndex) {
+				while (clockType::now() < nextFrame) {
+					std::this_thread::yield();
+				}
+				nextFrame += frameInterval;
+
+				Frame& frame{ renderer.getFrame() };
+				recordFrame(frame.drawList, scene, frameIndex);
+				const clockType::time_point submitStart{ clockType::now() };
+				frame.submitTime = submitStart;
+				renderer.submit();
+				handOff += clockType::now() - submitStart;
+			}
+			renderer.finish();
+
+			const double handOffMicroseconds{
+				std::chrono::duration<double, std::micro>{ handOff }.count() / frames
+			};
+			if (handOffMicroseconds < best.handOffMicroseconds) {
+				best = {
+					handOffMicroseconds,
+					renderer.getLatencyCounter().getFramesRendered(),
+					renderer.getLatencyCounter().getAverageMicroseconds()
+				};
+			}
+		}
+		return best;
+	}
+
+	void printResult(const char* name, const PipelineResult& result) {
+		std::cout << "  " << name << result.handOffMicroseconds << " us hand-off, "
+			<< result.framesRendered << " of " << frames << " frames rendered, "
+			<< result.latencyMicroseconds << " us submit to rendered\n";
+	}
+}
+
+int main() {
+	bench::BenchBitmaps benchBitmaps{};
+	const SoftwareBitmap sheetPixels{
+		sheetSize,
+		sheetSize,
+		std::vector<uint32_t>(static_cast<std::size_t>(sheetSize) * sheetSize, 0xFF808080u)
+	};
+	Scene scene{ benchBitmaps.makeBitmap(sheetPixels) };
+	constexpr int spritesPerRow{ sheetSize / spriteSize };
+	for (int i{ 0 }; i < spriteCount; ++i) {
+		const int sprite{ randomInt(0, spritesPerRow * spritesPerRow - 1) };
+		scene.instances.push_back({
+			{
+				static_cast<float>(randomInt(0, config::graphicsWidth - 1)),
+				static_cast<float>(randomInt(0, config::graphicsHeight - 1))
+			},
+			{
+				static_cast<float>(sprite % spritesPerRow * spriteSize),
+				static_cast<float>(sprite / spritesPerRow * spriteSize),
+				static_cast<float>(spriteSize),
+				static_cast<float>(spriteSize)
+			}
+		});
+	}
+
+	SoftwarePainter painter{};
+	painter.addBitmap(scene.sheet, sheetPixels);
+
+	std::cout << frames << " frames of " << spriteCount << " " << spriteSize << "x"
+		<< spriteSize << " sprites every " << frameInterval.count() << " us on "
+		<< std::thread::hardware_concurrency() << " cores\n";
+	printResult("persistent thread ", timePipeline<PersistentRenderer>(painter, scene));
+	printResult("thread per frame  ", timePipeline<ThreadPerFrameRenderer>(painter, scene));
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "Resampler.h"
+
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+//output frames per second through the resampler at the rate pairs the mixer
+//sees, pushed and pulled in blocks the size the mixer uses
+
+namespace {
+	using namespace wasp::sound;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int channels{ 2 };
+	constexpr std::size_t blockFrames{ 4096 };
+	constexpr int blocks{ 2000 };
+
+	//read at the end so the work can't be optimized out
+	volatile float sink{};
+
+	void bench(uint32_t inputRate, uint32_t outputRate) {
+		Resampler resampler{ inputRate, outputRate, channels };
+		std::vector<float> input(blockFrames * channels, 0.1f);
+		//room for everything one block can produce
+		const std::size_t maxOutputFrames{ blockFrames * outputRate / inputRate + 64 };
+		std::vector<float> output(maxOutputFrames * channels);
+
+		std::size_t outputFrames{ 0 };
+		const clockType::time_point start{ clockType::now() };
+		for (int block{ 0 }; block < blocks; ++block) {
+			resampler.push(input.data(), blockFrames);
+			outputFrames += resampler.pull(output.data(), maxOutputFrames);
+		}
+		const double seconds{
+			std::chrono::duration<double>{ clockType::now() - start }.count()
+		};
+		sink = output[0];
+		std::cout << inputRate << " -> " << outputRate << ", " << channels << " channels: "
+			<< outputFrames / seconds / 1e6 << " million output frames per second\n";
+	}
+}
+
+int main() {
+	bench(44100, 48000);
+	bench(22050, 48000);
+	bench(32000, 44100);
+	bench(48000, 44100);
+	bench(48000, 22050);
+	return 0;
+}
\ No newline at end of file
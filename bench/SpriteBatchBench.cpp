@@ -0,0 +1,178 @@
+#include "BenchBitmaps.h"
+#include "DrawList.h"
+#include "SoftwarePainter.h"
+#include "Config.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+//sprites per ms through the ways a frame can submit many sprites of one
+//sprite sheet: a drawSubBitmap call per sprite, the default
+//IBitmapDrawer::drawBitmapBatch loop, SoftwarePainter's own drawBitmapBatch,
+//and recording the batch into a DrawList then replaying it
+//each runs into a SoftwarePainter, where rasterizing dominates, and into a
+//drawer that does nothing, which leaves only the cost of submission
+
+namespace {
+	using namespace wasp;
+	using namespace wasp::graphics;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int sheetSize{ 64 };
+	constexpr int spriteSize{ 8 };
+	constexpr int spriteCount{ 10'000 };
+	constexpr int nullRuns{ 200 };
+	constexpr int paintRuns{ 10 };
+
+	std::mt19937 random{ 12345 };
+
+	int randomInt(int min, int max) {
+		return std::uniform_int_distribution<int>{ min, max }(random);
+	}
+
+	//touched once per sprite so nothing gets optimized out
+	volatile float sink{};
+
+	//takes each call and nothing else, batches loop over their instances
+	class NullDrawer
+		: public IBitmapDrawer
+		, public ITextDrawer
+	{
+	public:
+		void beginDraw() override {}
+
+		void drawBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction
+		) override {
+			sink = center.x;
+		}
+
+		void drawSubBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction,
+			const geometry::Rectangle& sourceRectangle
+		) override {
+			sink = center.x + sourceRectangle.x;
+		}
+
+		void drawBitmapBatch(
+			const CComPtr<ID2D1Bitmap>& bitmap,
+			utility::Span<const SpriteInstance> instances
+		) override {
+			for (const SpriteInstance& instance : instances) {
+				sink = instance.center.x + instance.sourceRectangle.x;
+			}
+		}
+
+		void drawText(
+			const geometry::Point2 pos,
+			const std::wstring& text,
+			const std::pair<float, float> bounds
+		) override {}
+
+		void endDraw() override {}
+	};
+
+	//whole pixel sprites, so the software painter takes its copy path
+	std::vector<SpriteInstance> makeInstances() {
+		constexpr int spritesPerRow{ sheetSize / spriteSize };
+		std::vector<SpriteInstance> toRet{};
+		for (int i{ 0 }; i < spriteCount; ++i) {
+			const int frame{ randomInt(0, spritesPerRow * spritesPerRow - 1) };
+			toRet.push_back({
+				{
+					static_cast<float>(randomInt(0, config::graphicsWidth)),
+					static_cast<float>(randomInt(0, config::graphicsHeight))
+				},
+				{
+					static_cast<float>(frame % spritesPerRow * spriteSize),
+					static_cast<float>(frame / spritesPerRow * spriteSize),
+					static_cast<float>(spriteSize),
+					static_cast<float>(spriteSize)
+				}
+			});
+		}
+		return toRet;
+	}
+
+	template <typename Submit>
+	double timeSpritesPerMillisecond(IDrawer& drawer, int runs, Submit submit) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			const clockType::time_point start{ clockType::now() };
+			drawer.beginDraw();
+			submit();
+			drawer.endDraw();
+			best = std::min(
+				best,
+				std::chrono::duration<double, std::milli>{ clockType::now() - start }.count()
+			);
+		}
+		return spriteCount / best;
+	}
+
+	template <typename Drawer>
+	void benchPaths(
+		Drawer& drawer,
+		int runs,
+		const CComPtr<ID2D1Bitmap>& sheet,
+		const std::vector<SpriteInstance>& instances
+	) {
+		std::cout << "  drawSubBitmap per sprite "
+			<< timeSpritesPerMillisecond(drawer, runs, [&] {
+				BitmapDrawInstruction bitmapDrawInstruction{ sheet };
+				for (const SpriteInstance& instance : instances) {
+					drawer.drawSubBitmap(
+						instance.center,
+						bitmapDrawInstruction,
+						instance.getPixelSourceRectangle()
+					);
+				}
+			}) << "\n";
+		std::cout << "  default batch loop       "
+			<< timeSpritesPerMillisecond(drawer, runs, [&] {
+				drawer.IBitmapDrawer::drawBitmapBatch(sheet, instances);
+			}) << "\n";
+		std::cout << "  drawer's drawBitmapBatch "
+			<< timeSpritesPerMillisecond(drawer, runs, [&] {
+				drawer.drawBitmapBatch(sheet, instances);
+			}) << "\n";
+
+		//the list is reused from frame to frame as the render thread does
+		DrawList drawList{};
+		std::cout << "  DrawList record + replay "
+			<< timeSpritesPerMillisecond(drawer, runs, [&] {
+				drawList.beginDraw();
+				drawList.drawBitmapBatch(sheet, instances);
+				drawList.endDraw();
+				drawList.replay(drawer, drawer);
+			}) << "\n";
+	}
+}
+
+int main() {
+	bench::BenchBitmaps benchBitmaps{};
+	const SoftwareBitmap sheetPixels{
+		sheetSize,
+		sheetSize,
+		std::vector<uint32_t>(static_cast<std::size_t>(sheetSize) * sheetSize, 0xFF808080u)
+	};
+	const CComPtr<ID2D1Bitmap> sheet{ benchBitmaps.makeBitmap(sheetPixels) };
+	const std::vector<SpriteInstance> instances{ makeInstances() };
+
+	std::cout << spriteCount << " " << spriteSize << "x" << spriteSize
+		<< " sprites from one sheet (sprites per ms)\n";
+	NullDrawer nullDrawer{};
+	std::cout << "submission only\n";
+	benchPaths(nullDrawer, nullRuns, sheet, instances);
+
+	SoftwarePainter painter{};
+	painter.addBitmap(sheet, sheetPixels);
+	std::cout << "into SoftwarePainter\n";
+	benchPaths(painter, paintRuns, sheet, instances);
+	return 0;
+}
\ No newline at end of file
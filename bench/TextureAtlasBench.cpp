@@ -0,0 +1,171 @@
+#include "BenchBitmaps.h"
+#include "TextureAtlas.h"
+#include "DrawList.h"
+#include "SoftwarePainter.h"
+#include "Config.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+//texture switches in a sample scene drawn from separate bitmaps against the
+//same scene drawn from atlas pages, with the atlases packed at the game's
+//page size and padding
+//switches are counted in recording order and after DrawList sorts the frame,
+//then both frames are replayed into a SoftwarePainter, which draws the atlas
+//pages from the pixels the builder packed
+
+namespace {
+	using namespace wasp;
+	using namespace wasp::graphics;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int imageCount{ 20 };
+	constexpr int minImageSize{ 16 };
+	constexpr int maxImageSize{ 64 };
+	constexpr int drawCount{ 2000 };
+	constexpr int layerCount{ 3 };
+	constexpr int runs{ 20 };
+
+	std::mt19937 random{ 12345 };
+
+	int randomInt(int min, int max) {
+		return std::uniform_int_distribution<int>{ min, max }(random);
+	}
+
+	SoftwareBitmap makeImage(int width, int height) {
+		const uint32_t color{ 0xFF000000u | (static_cast<uint32_t>(random()) & 0x00FFFFFFu) };
+		return { width, height, std::vector<uint32_t>(static_cast<std::size_t>(width) * height, color) };
+	}
+
+	struct SceneDraw {
+		int image{};
+		uint8_t layer{};
+		geometry::Point2 center{};
+	};
+
+	//where a draw takes its pixels from
+	struct DrawSource {
+		CComPtr<ID2D1Bitmap> bitmap{};
+		geometry::Rectangle rectangle{};
+	};
+
+	void record(
+		DrawList& drawList,
+		const std::vector<SceneDraw>& scene,
+		const std::vector<DrawSource>& sources
+	) {
+		drawList.beginDraw();
+		for (const SceneDraw& draw : scene) {
+			const DrawSource& source{ sources[draw.image] };
+			drawList.setLayer(draw.layer);
+			drawList.drawSubBitmap(draw.center, BitmapDrawInstruction{ source.bitmap }, source.rectangle);
+		}
+		drawList.endDraw();
+	}
+
+	//counts the first texture too, as DrawList::countTextureSwitches does
+	std::size_t countRecordingOrderSwitches(
+		const std::vector<SceneDraw>& scene,
+		const std::vector<DrawSource>& sources
+	) {
+		std::size_t toRet{ 0 };
+		ID2D1Bitmap* currentBitmap{};
+		for (const SceneDraw& draw : scene) {
+			ID2D1Bitmap* bitmap{ sources[draw.image].bitmap };
+			if (bitmap != currentBitmap) {
+				++toRet;
+				currentBitmap = bitmap;
+			}
+		}
+		return toRet;
+	}
+
+	double timeReplayMicroseconds(const DrawList& drawList, SoftwarePainter& painter) {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			const clockType::time_point start{ clockType::now() };
+			painter.beginDraw();
+			drawList.replay(painter, painter);
+			painter.endDraw();
+			best = std::min(
+				best,
+				std::chrono::duration<double, std::micro>{ clockType::now() - start }.count()
+			);
+		}
+		return best;
+	}
+}
+
+int main() {
+	bench::BenchBitmaps benchBitmaps{};
+
+	std::vector<SoftwareBitmap> images{};
+	for (int i{ 0 }; i < imageCount; ++i) {
+		images.push_back(makeImage(
+			randomInt(minImageSize, maxImageSize),
+			randomInt(minImageSize, maxImageSize)
+		));
+	}
+	std::vector<SceneDraw> scene{};
+	for (int i{ 0 }; i < drawCount; ++i) {
+		scene.push_back({
+			randomInt(0, imageCount - 1),
+			static_cast<uint8_t>(randomInt(0, layerCount - 1)),
+			{
+				static_cast<float>(randomInt(0, config::graphicsWidth)),
+				static_cast<float>(randomInt(0, config::graphicsHeight))
+			}
+		});
+	}
+
+	SoftwarePainter painter{};
+	std::vector<DrawSource> separateSources{};
+	for (const SoftwareBitmap& image : images) {
+		const CComPtr<ID2D1Bitmap> bitmap{ benchBitmaps.makeBitmap(image) };
+		painter.addBitmap(bitmap, image);
+		separateSources.push_back({
+			bitmap,
+			{ 0.0f, 0.0f, static_cast<float>(image.width), static_cast<float>(image.height) }
+		});
+	}
+
+	TextureAtlasBuilder atlasBuilder{ config::atlasPageSize, config::atlasPadding };
+	const clockType::time_point buildStart{ clockType::now() };
+	const std::vector<AtlasPlacement> placements{ atlasBuilder.build(images) };
+	const double buildMilliseconds{
+		std::chrono::duration<double, std::milli>{ clockType::now() - buildStart }.count()
+	};
+	std::vector<CComPtr<ID2D1Bitmap>> pageBitmaps{};
+	for (const SoftwareBitmap& page : atlasBuilder.getPages()) {
+		pageBitmaps.push_back(benchBitmaps.makeBitmap(page));
+		painter.addBitmap(pageBitmaps.back(), page);
+	}
+	std::vector<DrawSource> atlasSources{};
+	for (const AtlasPlacement& placement : placements) {
+		atlasSources.push_back({ pageBitmaps[placement.page], placement.rectangle });
+	}
+
+	std::cout << imageCount << " images of " << minImageSize << "-" << maxImageSize
+		<< " px into " << pageBitmaps.size() << " atlas pages in " << buildMilliseconds
+		<< " ms, " << atlasBuilder.getEfficiency() * 100.0 << "% efficient\n";
+	std::cout << drawCount << " draws over " << layerCount << " layers\n";
+
+	DrawList separateList{};
+	record(separateList, scene, separateSources);
+	DrawList atlasList{};
+	record(atlasList, scene, atlasSources);
+
+	std::cout << "texture switches (recording order, sorted)\n";
+	std::cout << "  separate bitmaps " << countRecordingOrderSwitches(scene, separateSources)
+		<< ", " << separateList.countTextureSwitches() << "\n";
+	std::cout << "  atlas pages      " << countRecordingOrderSwitches(scene, atlasSources)
+		<< ", " << atlasList.countTextureSwitches() << "\n";
+
+	std::cout << "software replay (us per frame)\n";
+	std::cout << "  separate bitmaps " << timeReplayMicroseconds(separateList, painter) << "\n";
+	std::cout << "  atlas pages      " << timeReplayMicroseconds(atlasList, painter) << "\n";
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "TscClock.h"
+
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+//cost of a read of TscClock against steady_clock, then how far the
+//calibrated clock drifts from steady_clock over a run
+//pass the drift duration in seconds, e.g. 3600 for the hour the game loop
+//has to stay on time for; the default is short so make bench stays quick
+
+namespace {
+	using wasp::time::TscClock;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr int reads{ 10'000'000 };
+	constexpr int runs{ 5 };
+	constexpr double defaultDriftSeconds{ 10.0 };
+	constexpr int driftSamples{ 10 };
+
+	//summed reads so the loops can't be optimized out
+	volatile int64_t sink{};
+
+	template <typename Clock>
+	double timeNanosecondsPerRead() {
+		double best{ 1e30 };
+		for (int run{ 0 }; run < runs; ++run) {
+			int64_t sum{ 0 };
+			const clockType::time_point start{ clockType::now() };
+			for (int i{ 0 }; i < reads; ++i) {
+				sum += Clock::now().time_since_epoch().count();
+			}
+			const double nanoseconds{
+				std::chrono::duration<double, std::nano>{ clockType::now() - start }.count()
+			};
+			sink = sum;
+			best = std::min(best, nanoseconds / reads);
+		}
+		return best;
+	}
+
+	//TscClock minus steady_clock, with the steady_clock read bracketed by two
+	//TscClock reads and the tightest of a few tries kept
+	double measureOffsetMicroseconds() {
+		constexpr int tries{ 16 };
+		double toRet{};
+		clockType::duration narrowestWindow{ clockType::duration::max() };
+		for (int i{ 0 }; i < tries; ++i) {
+			const TscClock::time_point before{ TscClock::now() };
+			const clockType::time_point steadyTime{ clockType::now() };
+			const TscClock::time_point after{ TscClock::now() };
+			if (after - before < narrowestWindow) {
+				narrowestWindow = after - before;
+				const TscClock::time_point tscTime{ before + (after - before) / 2 };
+				toRet = std::chrono::duration<double, std::micro>{ tscTime - steadyTime }.count();
+			}
+		}
+		return toRet;
+	}
+
+	void measureDrift(double driftSeconds) {
+		const std::chrono::duration<double> sampleInterval{ driftSeconds / driftSamples };
+		const double startOffset{ measureOffsetMicroseconds() };
+		const clockType::time_point start{ clockType::now() };
+		std::cout << "drift against steady_clock over " << driftSeconds << " s\n";
+		double largestDrift{ 0.0 };
+		for (int sample{ 1 }; sample <= driftSamples; ++sample) {
+			std::this_thread::sleep_until(
+				start + std::chrono::duration_cast<clockType::duration>(sampleInterval * sample)
+			);
+			const double elapsedSeconds{
+				std::chrono::duration<double>{ clockType::now() - start }.count()
+			};
+			const double drift{ measureOffsetMicroseconds() - startOffset };
+			largestDrift = std::max(largestDrift, std::abs(drift));
+			std::cout << "  " << elapsedSeconds << " s: " << drift << " us ("
+				<< drift / elapsedSeconds << " ppm)\n";
+		}
+		std::cout << "largest drift " << largestDrift << " us\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	double driftSeconds{ defaultDriftSeconds };
+	if (argc > 1) {
+		driftSeconds = std::max(std::strtod(argv[1], nullptr), 0.1);
+	}
+
+	TscClock::calibrate();
+	std::cout << "invariant tsc " << (TscClock::isTscInvariant() ? "yes" : "no")
+		<< ", using tsc " << (TscClock::isUsingTsc() ? "yes" : "no");
+	if (TscClock::isUsingTsc()) {
+		std::cout << ", " << TscClock::getTicksPerSecond() / 1e6 << " MHz";
+	}
+	std::cout << "\n";
+
+	std::cout << "ns per read\n";
+	std::cout << "  TscClock::now()     " << timeNanosecondsPerRead<TscClock>() << "\n";
+	std::cout << "  steady_clock::now() " << timeNanosecondsPerRead<clockType>() << "\n";
+
+	if (!TscClock::isUsingTsc()) {
+		std::cout << "TscClock is steady_clock here, no drift to measure\n";
+		return 0;
+	}
+	measureDrift(driftSeconds);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <functional>
+#include <chrono>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+namespace wasp::game::gameloop {
+
+	enum class TaskPriority {
+		high,
+		normal,
+		low
+	};
+
+	struct SlackUsage {
+		double slackSeconds{};	//time left before the deadline when draining began
+		double usedSeconds{};
+		uint32_t tasksRun{};
+	};
+
+	struct BackgroundTaskCounters {
+		uint64_t drains{};
+		uint64_t tasksRun{};
+		uint64_t tasksFinished{};
+		double totalSlackSeconds{};
+		double totalUsedSeconds{};
+		double maxOverrunSeconds{};	//worst time spent past a deadline
+		SlackUsage lastDrain{};
+	};
+
+	//deferrable work that the game loop runs in the time left over before its
+	//next deadline, at most frameBudget per frame
+	//heavy work should be split up, a task returns false to be called again
+	//and true once it is done; a task is never interrupted, so one that runs
+	//long will still eat into the next update
+	class BackgroundTaskScheduler {
+	public:
+		using taskType = std::function<bool()>;
+
+	private:
+		using secondsType = std::chrono::duration<double>;
+
+		static constexpr std::size_t priorityCount{ 3 };
+
+		std::array<std::deque<taskType>, priorityCount> queues{};
+		std::mutex queueMutex{};
+		std::atomic<std::size_t> pendingTaskCount{ 0 };
+		secondsType frameBudget{};
+		BackgroundTaskCounters counters{};
+
+	public:
+		explicit BackgroundTaskScheduler(secondsType frameBudget)
+			: frameBudget{ frameBudget } {
+		}
+
+		BackgroundTaskScheduler(const BackgroundTaskScheduler& other) = delete;
+		void operator=(const BackgroundTaskScheduler& other) = delete;
+
+		//safe to call from any thread
+		void post(taskType task, TaskPriority priority = TaskPriority::normal);
+
+		//runs tasks, highest priority first, until the queues are empty, the frame
+		//budget is used up or the deadline has passed
+		//meant for the loop thread only
+		template <typename ClockPolicy>
+		void drain(
+			ClockPolicy& clock,
+			typename ClockPolicy::timePointType currentTime,
+			typename ClockPolicy::timePointType deadline
+		) {
+			SlackUsage usage{};
+			usage.slackSeconds = std::max(secondsType{ deadline - currentTime }.count(), 0.0);
+
+			const typename ClockPolicy::timePointType limit{
+				std::min(
+					deadline,
+					currentTime 
+						+ std::chrono::duration_cast<typename ClockPolicy::durationType>(
+							frameBudget
+						)
+				)
+			};
+			const typename ClockPolicy::timePointType start{ currentTime };
+			taskType task{};
+			TaskPriority priority{};
+			while (currentTime < limit && popTask(task, priority)) {
+				const bool finished{ task() };
+				currentTime = clock.now();
+				++usage.tasksRun;
+				if (finished) {
+					++counters.tasksFinished;
+				}
+				else {
+					//back to the front so it carries on before anything newer
+					pushTaskFront(std::move(task), priority);
+				}
+			}
+			usage.usedSeconds = secondsType{ currentTime - start }.count();
+			recordDrain(usage, secondsType{ currentTime - deadline });
+		}
+
+		bool hasPendingTasks() const {
+			return pendingTaskCount.load(std::memory_order_relaxed) > 0;
+		}
+
+		std::size_t getPendingTaskCount() const {
+			return pendingTaskCount.load(std::memory_order_relaxed);
+		}
+
+		void setFrameBudget(secondsType frameBudget) {
+			this->frameBudget = frameBudget;
+		}
+
+		const BackgroundTaskCounters& getCounters() const {
+			return counters;
+		}
+
+	private:
+		bool popTask(taskType& task, TaskPriority& priority);
+		void pushTaskFront(taskType&& task, TaskPriority priority);
+		void recordDrain(const SlackUsage& usage, secondsType overrun);
+	};
+}
\ No newline at end of file
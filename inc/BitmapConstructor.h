@@ -3,6 +3,8 @@
 #include "framework.h"
 #include <string>
 
+#include "SoftwareRasterizer.h"	//SoftwareBitmap
+
 namespace wasp::graphics {
 	class BitmapConstructor {
 	private:
@@ -22,6 +24,16 @@ namespace wasp::graphics {
 			const CComPtr<ID2D1HwndRenderTarget> renderTargetPointer
 		);
 
+		//the converter has to be 32bpp premultiplied bgra, as made above
+		static SoftwareBitmap copyWicPixels(
+			const CComPtr<IWICFormatConverter> formatConverterPointer
+		);
+
+		CComPtr<ID2D1Bitmap> makeD2DBitmap(
+			const SoftwareBitmap& softwareBitmap,
+			const CComPtr<ID2D1HwndRenderTarget> renderTargetPointer
+		);
+
 	private:
 		void initWicFactory();
 		CComPtr<IWICBitmapFrameDecode> getWicBitmapFrameDecodePointer(
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <mutex>
+#include <algorithm>
 #include "framework.h"
 
 #include "ResourceStorage.h"
 #include "ResourceBase.h"
 #include "BitmapConstructor.h"
+#include "SoftwareRasterizer.h"	//SoftwareBitmap
+#include "Rectangle.h"
 
 #pragma warning(disable : 4250) //suppress inherit via dominance
 
@@ -14,6 +19,26 @@ namespace wasp::game::gameresource {
 	struct WicAndD2DBitmaps {
 		CComPtr<IWICFormatConverter> wicBitmap{};
 		CComPtr<ID2D1Bitmap> d2dBitmap{};
+
+		//null unless buildAtlases packed this image
+		CComPtr<ID2D1Bitmap> atlasBitmap{};
+		geometry::Rectangle atlasRectangle{};
+	};
+
+	//where to draw an image from, its atlas page if it has one
+	struct AtlasRegion {
+		CComPtr<ID2D1Bitmap> bitmap{};
+		geometry::Rectangle rectangle{};
+
+		//maps a rectangle in the original image into the region, clipped to
+		//the image so it can't reach a neighbour on the atlas page
+		geometry::Rectangle getSubRectangle(const geometry::Rectangle& local) const {
+			const float left{ std::clamp(local.x, 0.0f, rectangle.width) };
+			const float top{ std::clamp(local.y, 0.0f, rectangle.height) };
+			const float right{ std::clamp(local.x + local.width, left, rectangle.width) };
+			const float bottom{ std::clamp(local.y + local.height, top, rectangle.height) };
+			return { rectangle.x + left, rectangle.y + top, right - left, bottom - top };
+		}
 	};
 
 	class BitmapStorage
@@ -26,6 +51,15 @@ namespace wasp::game::gameresource {
 	private:
 		BitmapConstructor* bitmapConstructorPointer{};
 		CComPtr<ID2D1HwndRenderTarget> renderTargetPointer{};
+		std::vector<CComPtr<ID2D1Bitmap>> atlasPointers{};
+		std::vector<graphics::SoftwareBitmap> atlasPages{};
+		double atlasEfficiency{};
+
+		//the d2d factory is single threaded, so images loaded once the render
+		//target is set wait here for the render thread to make their bitmaps
+		std::mutex d2dQueueMutex{};
+		std::vector<std::shared_ptr<ResourceType>> d2dQueue{};
+		bool queueD2DBitmaps{};
 
 	public:
 		BitmapStorage(BitmapConstructor* bitmapConstructorPointer) 
@@ -50,8 +84,47 @@ namespace wasp::game::gameresource {
 		void setRenderTargetPointerAndLoadD2DBitmaps(
 			const CComPtr<ID2D1HwndRenderTarget>& renderTargetPointer
 		);
-		
+
+		//render thread only, between frames; makes the d2d bitmaps of the
+		//images loaded or reloaded since the last call
+		void createQueuedD2DBitmaps();
+
+		//packs every loaded image into pageSize square atlases, needs the
+		//render target set; images that don't fit a page keep only their own
+		//bitmap, and so do images reloaded afterwards
+		void buildAtlases(int pageSize, int padding);
+
+		//the atlas page and sub-rectangle of an image, or its own bitmap and
+		//full size when it isn't packed; a null bitmap if the id isn't loaded
+		AtlasRegion getAtlasRegion(const std::wstring& id);
+
+		std::size_t getAtlasCount() const {
+			return atlasPointers.size();
+		}
+
+		//the d2d bitmap of each page, in the same order as getAtlasPages
+		const std::vector<CComPtr<ID2D1Bitmap>>& getAtlasBitmaps() const {
+			return atlasPointers;
+		}
+
+		//the packed pixels of each page, kept so a SoftwarePainter can draw
+		//from the atlases too
+		const std::vector<graphics::SoftwareBitmap>& getAtlasPages() const {
+			return atlasPages;
+		}
+
+		//image pixels over atlas pixels
+		double getAtlasEfficiency() const {
+			return atlasEfficiency;
+		}
+
 	private:
+		std::shared_ptr<ResourceType> makeResource(
+			const std::wstring& id,
+			const std::wstring& fileName,
+			const resource::ResourceOriginVariant& origin
+		);
+		void queueD2DBitmap(const std::shared_ptr<ResourceType>& resourcePointer);
 		void loadD2DBitmap(ResourceType& resource);
 		void throwIfCannotConstructD2DBitmaps();
 	};
@@ -27,8 +27,18 @@ namespace wasp::config {
 	constexpr DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment{
 		DWRITE_PARAGRAPH_ALIGNMENT_NEAR
 	};
+	constexpr int atlasPageSize{ 2048 };
+	constexpr int atlasPadding{ 1 }; //pixels of repeated edge around each image
 
 	//game
 	constexpr int updatesPerSecond{ 60 };
-	constexpr int maxUpdatesWithoutFrame{ 5 };
+	constexpr int maxUpdatesWithoutFrame{ 5 }; //upper bound, adapts to update cost
+	constexpr int maxFramesPerSecond{ 120 }; // <= 0 for uncapped
+	constexpr int throttledUpdatesPerSecond{ 10 }; //while out of focus
+
+	//debug
+	constexpr int hitchHistoryFrames{ 240 };
+	constexpr int hitchFramesAfter{ 60 }; //frames after a hitch that go in its dump
+	constexpr double hitchThresholdSeconds{ 1.0 / 20.0 };
+	constexpr char hitchDumpFilePrefix[]{ "hitch_" };
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
+
+#include "IBitmapDrawer.h"
+#include "ITextDrawer.h"
+
+namespace wasp::graphics {
+	//opaque sorts before alpha in a layer; drawers blend both the same way
+	//for now, so it only affects ordering
+	enum class BlendMode : uint8_t {
+		opaque,
+		alpha
+	};
+
+	//records draw calls as plain commands so they can be replayed into a real
+	//drawer later, possibly on another thread
+	//endDraw sorts the commands by layer, then blend mode, then texture, so
+	//within a layer draws are grouped by texture and only draws of the same
+	//texture keep their relative order; put anything that has to overlap in
+	//a set order on different layers
+	//storage is reused from frame to frame so a steady scene doesn't allocate
+	class DrawList
+		: public IBitmapDrawer
+		, public ITextDrawer
+	{
+	private:
+		enum class CommandType : uint8_t {
+			bitmap,
+			subBitmap,
+			bitmapBatch,
+			text
+		};
+
+		struct DrawCommand {
+			CommandType type{};
+			//layer, blend mode, texture index from high to low bits
+			uint32_t sortKey{};
+			geometry::Point2 position{};
+			geometry::Rectangle sourceRectangle{};
+			float rotationDegrees{};
+			float opacity{};
+			float scale{};
+			float boundsWidth{};
+			float boundsHeight{};
+			//instances for bitmapBatch, characters for text
+			uint32_t firstElement{};
+			uint32_t elementCount{};
+		};
+		static_assert(std::is_trivially_copyable_v<DrawCommand>);
+
+		struct SortEntry {
+			uint32_t key{};
+			uint32_t commandIndex{};
+		};
+
+		//text has no texture, it goes after the bitmaps of its layer
+		static constexpr uint16_t textTextureIndex{ 0xFFFF };
+		static constexpr std::size_t maxTextures{ textTextureIndex };
+
+		std::vector<DrawCommand> commands{};
+		std::size_t commandCount{};
+
+		std::vector<SortEntry> sortEntries{};
+		std::vector<SortEntry> sortScratch{};
+
+		//textures used this frame, commands refer to them by index
+		std::vector<CComPtr<ID2D1Bitmap>> textures{};
+		std::size_t textureCount{};
+		std::size_t lastTextureIndex{};
+
+		//instances of every batch of the frame, back to back
+		std::vector<SpriteInstance> instances{};
+		std::size_t instanceCount{};
+
+		std::vector<wchar_t> characters{};
+		std::size_t characterCount{};
+
+		uint8_t layer{};
+		BlendMode blendMode{ BlendMode::alpha };
+
+		//replay isn't reentrant, so it can keep one string for text commands
+		mutable std::wstring replayText{};
+
+	public:
+		DrawList() = default;
+
+		DrawList(const DrawList& other) = delete;
+		void operator=(const DrawList& other) = delete;
+
+		void beginDraw() override;
+
+		//apply to the commands recorded after them, beginDraw resets both
+		void setLayer(uint8_t layer) {
+			this->layer = layer;
+		}
+
+		void setBlendMode(BlendMode blendMode) {
+			this->blendMode = blendMode;
+		}
+
+		void drawBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction
+		) override;
+
+		void drawSubBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction,
+			const geometry::Rectangle& sourceRectangle
+		) override;
+
+		void drawBitmapBatch(
+			const CComPtr<ID2D1Bitmap>& bitmap,
+			utility::Span<const SpriteInstance> instances
+		) override;
+
+		void drawText(
+			const geometry::Point2 pos,
+			const std::wstring& text,
+			const std::pair<float, float> bounds
+		) override;
+
+		//sorts the frame
+		void endDraw() override;
+
+		//replays in sorted order, so endDraw has to be called first
+		//does not call beginDraw or endDraw on the targets
+		void replay(IBitmapDrawer& bitmapDrawer, ITextDrawer& textDrawer) const;
+
+		std::size_t size() const {
+			return commandCount;
+		}
+
+		std::size_t getTextureCount() const {
+			return textureCount;
+		}
+
+		//how often replay changes texture between bitmap commands
+		std::size_t countTextureSwitches() const;
+
+	private:
+		DrawCommand& nextCommand(CommandType type, uint16_t textureIndex);
+		const CComPtr<ID2D1Bitmap>& getTexture(const DrawCommand& command) const;
+		uint16_t getTextureIndex(ID2D1Bitmap* bitmap);
+		void sortCommands();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace wasp::game::gameloop {
+
+	struct FrameSkipCounters {
+		uint64_t updates{};
+		uint64_t catchUpUpdates{};	//updates run with no time left to draw
+		uint64_t frames{};
+		uint64_t forcedFrames{};	//frames drawn in the middle of catching up
+		uint64_t droppedUpdates{};	//backlog thrown away to avoid a spiral of death
+		int catchUpLimit{};
+		double averageUpdateSeconds{};
+		double averageDrawSeconds{};
+	};
+
+	//decides how many updates may run back to back before a frame is forced, and
+	//when the backlog is too large to ever catch up on
+	//the limit is picked so a frame still goes out at least every
+	//maxUpdatesWithoutFrame update periods given the recent update and draw cost
+	class FrameSkipController {
+	private:
+		using secondsType = std::chrono::duration<double>;
+
+		static constexpr double smoothing{ 0.9 };
+		//backlog beyond this many limits' worth of updates is dropped
+		static constexpr int backlogLimitMultiplier{ 2 };
+
+		int maxUpdatesWithoutFrame{};
+		double updatePeriodSeconds{};
+		FrameSkipCounters counters{};
+
+	public:
+		FrameSkipController(int maxUpdatesWithoutFrame, secondsType updatePeriod);
+
+		void recordUpdate(secondsType cost, bool catchingUp);
+		void recordFrame(secondsType cost, bool forced);
+		void recordDroppedUpdates(uint64_t droppedUpdates);
+
+		int getCatchUpLimit() const {
+			return counters.catchUpLimit;
+		}
+
+		bool shouldForceFrame(int updatesWithoutFrame) const {
+			return updatesWithoutFrame >= counters.catchUpLimit;
+		}
+
+		//how many update periods behind real time we can be before dropping
+		double getMaxBacklogUpdates() const {
+			return static_cast<double>(maxUpdatesWithoutFrame) * backlogLimitMultiplier;
+		}
+
+		const FrameSkipCounters& getCounters() const {
+			return counters;
+		}
+
+	private:
+		void updateCatchUpLimit();
+	};
+}
\ No newline at end of file
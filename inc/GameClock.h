@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#include "TscClock.h"
+
+//clock policies for the game loop
+//a policy provides now() and sleepUntil(), and says whether it is virtual
+namespace wasp::game::gameloop {
+
+	//real time, used when running with a window
+	class SteadyClock {
+	public:
+		using clockType = std::chrono::steady_clock;
+		using timePointType = clockType::time_point;
+		using durationType = clockType::duration;
+
+		static constexpr bool isVirtual{ false };
+
+		timePointType now() const {
+			return clockType::now();
+		}
+
+		void sleepUntil(timePointType timePoint) {
+			std::this_thread::sleep_until(timePoint);
+		}
+	};
+
+	//real time read from the cpu timestamp counter, on steady_clock's timeline
+	//falls back to steady_clock unless time::TscClock::calibrate() found an
+	//invariant counter
+	class TscClock {
+	public:
+		using clockType = time::TscClock;
+		using timePointType = clockType::time_point;
+		using durationType = clockType::duration;
+
+		static constexpr bool isVirtual{ false };
+
+		timePointType now() const {
+			return clockType::now();
+		}
+
+		void sleepUntil(timePointType timePoint) {
+			std::this_thread::sleep_until(timePoint);
+		}
+	};
+
+	//simulated time, only moves when told to, sleeping just jumps ahead
+	class VirtualClock {
+	public:
+		using clockType = std::chrono::steady_clock;
+		using timePointType = clockType::time_point;
+		using durationType = clockType::duration;
+
+		static constexpr bool isVirtual{ true };
+
+	private:
+		timePointType currentTime{};
+
+	public:
+		timePointType now() const {
+			return currentTime;
+		}
+
+		void sleepUntil(timePointType timePoint) {
+			if (timePoint > currentTime) {
+				currentTime = timePoint;
+			}
+		}
+
+		void advance(durationType duration) {
+			currentTime += duration;
+		}
+	};
+}
\ No newline at end of file
@@ -2,50 +2,603 @@
 
 #include <functional>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <stdexcept>
 #include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <utility>
+#include <string>
+#include <type_traits>
+
+#include "GameClock.h"
+#include "FrameSkipController.h"
+#include "BackgroundTaskScheduler.h"
+#include "SubsystemScheduler.h"
+#include "HitchDetector.h"
+#include "TimerService.h"
 
 namespace wasp::game::gameloop {
 
+	struct HeadlessRunResult {
+		uint64_t updates{};
+		uint64_t draws{};
+		std::chrono::nanoseconds simulatedTime{};
+		std::chrono::nanoseconds wallTime{};
+	};
+
 	//making this a class because i want to be able to stop it
-	class GameLoop {
+	//the update and draw callables are template parameters so lambdas get
+	//called directly and can be inlined into the loop, the defaults keep the
+	//old type erased behaviour
+	template <
+		typename ClockPolicy, 
+		typename UpdateFunction = std::function<void()>,
+		typename DrawFunction = std::function<void(double)>
+	>
+	class BasicGameLoop {
 	private:
-		using clockType = std::chrono::steady_clock;
-		using timePointType = clockType::time_point;
-		using durationType = clockType::duration;
+		using timePointType = typename ClockPolicy::timePointType;
+		using durationType = typename ClockPolicy::durationType;
+
+		//sleep until this long before a deadline, then spin the rest of the way
+		static constexpr std::chrono::microseconds spinMargin{ 2'000 };
+		static constexpr std::chrono::microseconds defaultBackgroundTaskBudget{ 4'000 };
 
-		bool running{};
+		//a clock on another timeline, like a virtual one, can't be mixed with the
+		//times other threads record, so those loops record no hitches
+		static constexpr bool recordsHitches{
+			!ClockPolicy::isVirtual
+				&& std::is_same_v<timePointType, debug::HitchDetector::timePointType>
+		};
+
+		ClockPolicy clock{};
+		//written by stop() from any thread, read by the loops without a lock
+		std::atomic_bool running{ false };
 		int updatesPerSecond{};
-		int maxUpdatesWithoutFrame{};
-		std::function<void()> updateFunction{};
-		std::function<void(double)> drawFunction{};
+		int maxFramesPerSecond{};	// <= 0 draws as often as possible
+		UpdateFunction updateFunction;
+		DrawFunction drawFunction;
+		FrameSkipController frameSkipController;
+		BackgroundTaskScheduler backgroundTaskScheduler{ defaultBackgroundTaskBudget };
+		SubsystemScheduler subsystemScheduler{};
+		debug::HitchDetector* hitchDetector{};
+		time::TimerService* timerService{};
+
+		//while throttled nothing is drawn and the loop blocks between ticks of
+		//throttledFunction, which should at least keep the message pump going
+		std::atomic_bool throttled{ false };
+		int throttledUpdatesPerSecond{ 10 };
+		std::function<void()> throttledFunction{};
+		std::mutex throttleMutex{};
+		std::condition_variable throttleCondition{};
 
 	public:
-		GameLoop(
+		BasicGameLoop(
 			int updatesPerSecond, 
 			int maxUpdatesWithoutFrame,
-			const std::function<void()>& updateFunction,
-			const std::function<void(double)>& drawFunction
+			int maxFramesPerSecond,
+			UpdateFunction updateFunction,
+			DrawFunction drawFunction
 		)
-			: running{ false }
-			, updatesPerSecond { updatesPerSecond}
-			, maxUpdatesWithoutFrame{ maxUpdatesWithoutFrame }
-			, updateFunction{ updateFunction }
-			, drawFunction{ drawFunction }{
+			: updatesPerSecond { updatesPerSecond}
+			, maxFramesPerSecond{ maxFramesPerSecond }
+			, updateFunction{ std::move(updateFunction) }
+			, drawFunction{ std::move(drawFunction) }
+			, frameSkipController{ 
+				maxUpdatesWithoutFrame, 
+				std::chrono::duration<double>{ 1.0 / updatesPerSecond }
+			}{
 		};
 
 		void run();
 
+		//runs updateCount updates back to back, drawing after every drawEvery'th
+		//update (never if 0); a virtual clock is advanced one update per tick
+		HeadlessRunResult runHeadless(uint64_t updateCount, uint64_t drawEvery = 0);
+
 		void stop();
 
+		//safe to call from inside the update function or from another thread
+		void throttle();
+		void unthrottle();
+
+		bool isThrottled() const {
+			return throttled.load(std::memory_order_acquire);
+		}
+
+		bool isRunning() const {
+			return running.load(std::memory_order_acquire);
+		}
+
+		//pass the update function for low rate updates, or just the message pump
+		//to pause the game while throttled
+		void setThrottledFunction(
+			int throttledUpdatesPerSecond,
+			const std::function<void()>& throttledFunction
+		) {
+			this->throttledUpdatesPerSecond = throttledUpdatesPerSecond;
+			this->throttledFunction = throttledFunction;
+		}
+
+		ClockPolicy& getClock() {
+			return clock;
+		}
+
+		const FrameSkipCounters& getFrameSkipCounters() const {
+			return frameSkipController.getCounters();
+		}
+
+		//registers a subsystem ticking at its own rate beside the update function,
+		//on the same timeline; a tick due at the same time as an update runs
+		//after it; register everything before running the loop
+		std::size_t addSubsystem(
+			const std::string& name,
+			int ticksPerSecond,
+			double phase,
+			const SubsystemScheduler::tickFunctionType& tickFunction
+		) {
+			return subsystemScheduler.addSubsystem(
+				name, 
+				ticksPerSecond, 
+				phase, 
+				tickFunction
+			);
+		}
+
+		const SubsystemScheduler& getSubsystemScheduler() const {
+			return subsystemScheduler;
+		}
+
+		//updates and draws are recorded into it and each drawn frame ends a
+		//frame there, only with a clock on the detector's timeline; may be null
+		void setHitchDetector(debug::HitchDetector* hitchDetector) {
+			this->hitchDetector = hitchDetector;
+		}
+
+		//timers delivered to the loop thread are dispatched once per pass, so they
+		//run up to a frame late; may be null
+		void setTimerService(time::TimerService* timerService) {
+			this->timerService = timerService;
+		}
+
+		//tasks posted here run in the slack before the next update or frame,
+		//only while frames are capped since an uncapped loop has no slack
+		BackgroundTaskScheduler& getBackgroundTaskScheduler() {
+			return backgroundTaskScheduler;
+		}
+
 	private:
-		static timePointType getCurrentTime();
+		timePointType getCurrentTime() const;
+
+		static durationType calcPeriod(int timesPerSecond);
+
+		void waitUntil(timePointType deadline);
+
+		void runThrottled();
+
+		//runs subsystem ticks due before both currentTime and nextUpdate,
+		//returns true if any ran
+		bool runSubsystems(
+			timePointType currentTime,
+			timePointType nextUpdate,
+			timePointType timelineStart
+		);
+
+		void recordPhase(debug::FramePhase phase, timePointType begin, timePointType end);
+		void recordFrameEnd(timePointType frameEnd);
+		void recordFrameRestart(timePointType frameBegin);
+
+		//the earlier of nextUpdate and the next subsystem tick
+		timePointType calcNextTick(
+			timePointType nextUpdate, 
+			timePointType timelineStart
+		) const;
+
+		//returns the time the frame finished
+		timePointType drawFrame(
+			timePointType currentTime,
+			timePointType timeOfLastUpdate,
+			durationType timeBetweenUpdates,
+			bool forced
+		);
 
 		static double calcDeltaTime(
+			timePointType currentTime,
 			timePointType timeOfLastUpdate,
 			durationType timeBetweenUpdates
 		);
-
-		static durationType calcTimeSinceLastUpdate(timePointType timeOfLastUpdate);
 	};
+
+	//lets a loop built straight from lambdas pick up their types
+	template <typename UpdateFunction, typename DrawFunction>
+	BasicGameLoop(int, int, int, UpdateFunction, DrawFunction)
+		-> BasicGameLoop<SteadyClock, UpdateFunction, DrawFunction>;
+
+	//builds a loop on a clock other than the default straight from lambdas
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction> makeGameLoop(
+		int updatesPerSecond,
+		int maxUpdatesWithoutFrame,
+		int maxFramesPerSecond,
+		UpdateFunction updateFunction,
+		DrawFunction drawFunction
+	) {
+		return {
+			updatesPerSecond,
+			maxUpdatesWithoutFrame,
+			maxFramesPerSecond,
+			std::move(updateFunction),
+			std::move(drawFunction)
+		};
+	}
+
+	//type erased loops, for when the callables aren't known up front
+	using GameLoop = BasicGameLoop<SteadyClock>;
+	using HeadlessGameLoop = BasicGameLoop<VirtualClock>;
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::run() {
+		const durationType timeBetweenUpdates{ calcPeriod(updatesPerSecond) };
+		const bool pacingFrames{ maxFramesPerSecond > 0 };
+		const durationType timeBetweenFrames{ 
+			pacingFrames ? calcPeriod(maxFramesPerSecond) : durationType::zero()
+		};
+
+		//read the clock once per pass and again only after something that takes
+		//time, rather than before every comparison
+		timePointType currentTime{ getCurrentTime() };
+		timePointType nextUpdate{ currentTime };
+		timePointType nextFrame{ currentTime };
+		timePointType timeOfLastUpdate{ currentTime };
+		//subsystem time is measured from here, it moves forward by any time
+		//the loop skips so subsystems skip it too
+		timePointType timelineStart{ currentTime };
+		int updatesWithoutFrame{ 0 };
+		subsystemScheduler.restart();
+
+		running.store(true, std::memory_order_release);
+		while (isRunning()) {
+			currentTime = getCurrentTime();
+			if (timerService && timerService->dispatch() > 0) {
+				currentTime = getCurrentTime();
+			}
+			//block at a low tick rate until unthrottled, then resume without
+			//trying to catch up on the time spent away
+			if (isThrottled()) {
+				runThrottled();
+				currentTime = getCurrentTime();
+				timelineStart += currentTime - nextUpdate;
+				nextUpdate = currentTime;
+				nextFrame = currentTime;
+				timeOfLastUpdate = currentTime;
+				updatesWithoutFrame = 0;
+				recordFrameRestart(currentTime);
+				continue;
+			}
+			//force a frame once the controller says we've caught up long enough
+			if (frameSkipController.shouldForceFrame(updatesWithoutFrame)) {
+				currentTime = drawFrame(
+					currentTime, 
+					timeOfLastUpdate, 
+					timeBetweenUpdates, 
+					true
+				);
+				updatesWithoutFrame = 0;
+			}
+			//subsystem ticks due before the update
+			if (runSubsystems(currentTime, nextUpdate, timelineStart)) {
+				currentTime = getCurrentTime();
+			}
+			//update if time
+			if (currentTime >= nextUpdate) {
+				const timePointType updateStart{ currentTime };
+				updateFunction();
+				currentTime = getCurrentTime();
+				recordPhase(debug::FramePhase::update, updateStart, currentTime);
+				//measure alpha from when the update was due, not when it finished
+				timeOfLastUpdate = nextUpdate;
+				nextUpdate += timeBetweenUpdates;
+				frameSkipController.recordUpdate(
+					currentTime - updateStart, 
+					currentTime >= nextUpdate
+				);
+				//too far behind to ever catch up, run slow instead of spiralling
+				const double backlogUpdates{
+					std::chrono::duration<double>{ currentTime - nextUpdate }
+						/ std::chrono::duration<double>{ timeBetweenUpdates }
+				};
+				if (backlogUpdates > frameSkipController.getMaxBacklogUpdates()) {
+					frameSkipController.recordDroppedUpdates(
+						static_cast<uint64_t>(backlogUpdates)
+					);
+					timelineStart += currentTime - nextUpdate;
+					nextUpdate = currentTime;
+					timeOfLastUpdate = nextUpdate - timeBetweenUpdates;
+				}
+			}
+			//draw frames if possible
+			if (currentTime < nextUpdate) {
+				updatesWithoutFrame = 0;
+				const timePointType nextTick{ calcNextTick(nextUpdate, timelineStart) };
+				if (pacingFrames) {
+					if (currentTime >= nextFrame) {
+						currentTime = drawFrame(
+							currentTime, 
+							timeOfLastUpdate, 
+							timeBetweenUpdates, 
+							false
+						);
+						nextFrame += timeBetweenFrames;
+						if (nextFrame < currentTime) {
+							nextFrame = currentTime;
+						}
+					}
+					const timePointType waitTarget{ std::min(nextTick, nextFrame) };
+					//stop short of the spin so the deadline is still hit precisely,
+					//a virtual clock has no real slack to fill
+					if constexpr (!ClockPolicy::isVirtual) {
+						backgroundTaskScheduler.drain(
+							clock, 
+							currentTime, 
+							waitTarget - spinMargin
+						);
+					}
+					waitUntil(waitTarget);
+				}
+				else {
+					while (currentTime < nextTick && isRunning()) {
+						currentTime = drawFrame(
+							currentTime, 
+							timeOfLastUpdate, 
+							timeBetweenUpdates, 
+							false
+						);
+						//a virtual clock would never get to the next update
+						if constexpr (ClockPolicy::isVirtual) {
+							clock.sleepUntil(nextTick);
+							currentTime = getCurrentTime();
+						}
+					}
+				}
+			}
+			else {
+				++updatesWithoutFrame;
+			}
+		}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	typename BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::timePointType
+		BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::drawFrame(
+			timePointType currentTime,
+			timePointType timeOfLastUpdate,
+			durationType timeBetweenUpdates,
+			bool forced
+		) {
+		drawFunction(calcDeltaTime(currentTime, timeOfLastUpdate, timeBetweenUpdates));
+		const timePointType drawEnd{ getCurrentTime() };
+		frameSkipController.recordFrame(drawEnd - currentTime, forced);
+		recordPhase(debug::FramePhase::draw, currentTime, drawEnd);
+		recordFrameEnd(drawEnd);
+		return drawEnd;
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	HeadlessRunResult BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::runHeadless(
+		uint64_t updateCount, 
+		uint64_t drawEvery
+	) {
+		const durationType timeBetweenUpdates{ calcPeriod(updatesPerSecond) };
+		const auto wallStart{ std::chrono::steady_clock::now() };
+		const timePointType simulatedStart{ getCurrentTime() };
+
+		HeadlessRunResult toRet{};
+		subsystemScheduler.restart();
+		running.store(true, std::memory_order_release);
+		while (isRunning() && toRet.updates < updateCount) {
+			//timed by update count, the clock may not be virtual
+			subsystemScheduler.runUntil(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+					timeBetweenUpdates * toRet.updates
+				)
+			);
+			updateFunction();
+			++toRet.updates;
+			if constexpr (ClockPolicy::isVirtual) {
+				clock.advance(timeBetweenUpdates);
+			}
+			if (drawEvery && toRet.updates % drawEvery == 0) {
+				//drawn exactly on an update so nothing to interpolate
+				drawFunction(0.0);
+				++toRet.draws;
+			}
+		}
+		subsystemScheduler.runUntil(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				timeBetweenUpdates * toRet.updates
+			)
+		);
+		running.store(false, std::memory_order_release);
+
+		toRet.simulatedTime = getCurrentTime() - simulatedStart;
+		toRet.wallTime = std::chrono::steady_clock::now() - wallStart;
+		return toRet;
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::stop() {
+		{
+			//under the lock so a throttled wait can't miss it
+			std::lock_guard<std::mutex> lock{ throttleMutex };
+			running.store(false, std::memory_order_release);
+		}
+		throttleCondition.notify_all();
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::throttle() {
+		throttled.store(true, std::memory_order_release);
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::unthrottle() {
+		{
+			std::lock_guard<std::mutex> lock{ throttleMutex };
+			throttled.store(false, std::memory_order_release);
+		}
+		throttleCondition.notify_all();
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::runThrottled() {
+		const durationType timeBetweenTicks{ calcPeriod(throttledUpdatesPerSecond) };
+		timePointType nextTick{ getCurrentTime() };
+
+		std::unique_lock<std::mutex> lock{ throttleMutex };
+		while (isRunning() && isThrottled()) {
+			lock.unlock();
+			if (throttledFunction) {
+				throttledFunction();
+			}
+			nextTick += timeBetweenTicks;
+			if (nextTick < getCurrentTime()) {
+				nextTick = getCurrentTime();
+			}
+			lock.lock();
+			//always a real wait, throttling only makes sense with a window anyway
+			throttleCondition.wait_for(
+				lock, 
+				nextTick - getCurrentTime(), 
+				[&] { return !isRunning() || !isThrottled(); }
+			);
+			if constexpr (ClockPolicy::isVirtual) {
+				clock.sleepUntil(nextTick);
+			}
+		}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	bool BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::runSubsystems(
+		timePointType currentTime,
+		timePointType nextUpdate,
+		timePointType timelineStart
+	) {
+		if (subsystemScheduler.empty()) {
+			return false;
+		}
+		//exclusive limit, so a tick due now runs but one due with the update
+		//waits for it
+		const timePointType limit{ std::min(currentTime + durationType{ 1 }, nextUpdate) };
+		return subsystemScheduler.runUntil(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(limit - timelineStart)
+		) > 0;
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::recordPhase(
+		debug::FramePhase phase,
+		timePointType begin,
+		timePointType end
+	) {
+		if constexpr (recordsHitches) {
+			if (hitchDetector) {
+				hitchDetector->recordPhase(phase, begin, end);
+			}
+		}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::recordFrameEnd(
+		timePointType frameEnd
+	) {
+		if constexpr (recordsHitches) {
+			if (hitchDetector) {
+				hitchDetector->endFrame(frameEnd);
+			}
+		}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::recordFrameRestart(
+		timePointType frameBegin
+	) {
+		if constexpr (recordsHitches) {
+			if (hitchDetector) {
+				hitchDetector->restartFrame(frameBegin);
+			}
+		}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	typename BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::timePointType
+		BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::calcNextTick(
+			timePointType nextUpdate,
+			timePointType timelineStart
+		) const {
+		if (subsystemScheduler.empty()) {
+			return nextUpdate;
+		}
+		const timePointType nextSubsystemTick{
+			timelineStart + std::chrono::duration_cast<durationType>(
+				subsystemScheduler.getNextDueTime()
+			)
+		};
+		return std::min(nextUpdate, nextSubsystemTick);
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	typename BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::timePointType 
+		BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::getCurrentTime() const {
+		return clock.now();
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	typename BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::durationType 
+		BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::calcPeriod(int timesPerSecond) {
+		using periodType = typename durationType::period;
+		return durationType{
+			static_cast<typename durationType::rep>(
+				((1.0 / timesPerSecond) * periodType::den)
+				/ periodType::num
+			)
+		};
+	}
+
+	//the OS sleep is only accurate to a millisecond or so even with a raised
+	//timer resolution, so hand off to a spin for the last stretch
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	void BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::waitUntil(timePointType deadline) {
+		if constexpr (ClockPolicy::isVirtual) {
+			clock.sleepUntil(deadline);
+			return;
+		}
+		const timePointType sleepUntil{ deadline - spinMargin };
+		if (getCurrentTime() < sleepUntil) {
+			clock.sleepUntil(sleepUntil);
+		}
+		while (getCurrentTime() < deadline && isRunning()) {}
+	}
+
+	template <typename ClockPolicy, typename UpdateFunction, typename DrawFunction>
+	double BasicGameLoop<ClockPolicy, UpdateFunction, DrawFunction>::calcDeltaTime(
+		timePointType currentTime,
+		timePointType timeOfLastUpdate,
+		durationType timeBetweenUpdates
+	) {
+		//floating point division, integer durations would truncate to 0 or 1
+		double deltaTime{
+			std::chrono::duration<double>{ currentTime - timeOfLastUpdate }
+				/ std::chrono::duration<double>{ timeBetweenUpdates }
+		};
+		if (deltaTime < 0.0) {
+			throw std::runtime_error{ "Error deltaTime < 0" };
+		}
+		if (deltaTime > 1.0) {
+			return 1.0;
+		}
+		return deltaTime;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <chrono>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "TscClock.h"
+
+namespace wasp::debug {
+
+	enum class FramePhase {
+		update,
+		draw,
+		present,
+		messagePump
+	};
+
+	constexpr std::size_t framePhaseCount{ 4 };
+
+	struct PhaseRecord {
+		int64_t firstBeginNanoseconds{};
+		int64_t totalNanoseconds{};
+		uint32_t count{};	//several updates or pumps can land in one frame
+	};
+
+	//times are nanoseconds since the detector was made
+	struct FrameRecord {
+		uint64_t frameIndex{};
+		int64_t beginNanoseconds{};
+		int64_t endNanoseconds{};
+		std::array<PhaseRecord, framePhaseCount> phases{};
+	};
+
+	//keeps the last historySize frames and writes the frames around any frame
+	//longer than hitchThreshold to dumpFilePrefix<frame index>.csv
+	//a frame runs from the end of one drawn frame to the end of the next
+	//recording never allocates, everything is sized up front; a dump copies
+	//the history and its own thread writes the file, so the loop thread never
+	//waits on the disk right after a hitch
+	//all calls except recordPresent belong to the loop thread
+	class HitchDetector {
+	public:
+		//cheap to read, and on steady_clock's timeline either way
+		using clockType = time::TscClock;
+		using timePointType = clockType::time_point;
+
+		//times one phase for as long as it is in scope, does nothing if given null
+		class PhaseScope {
+		private:
+			HitchDetector* hitchDetector{};
+			FramePhase phase{};
+			timePointType begin{};
+
+		public:
+			PhaseScope(HitchDetector* hitchDetector, FramePhase phase)
+				: hitchDetector{ hitchDetector }
+				, phase{ phase }
+				, begin{ hitchDetector ? clockType::now() : timePointType{} } {
+			}
+
+			PhaseScope(const PhaseScope& other) = delete;
+			void operator=(const PhaseScope& other) = delete;
+
+			~PhaseScope() {
+				if (hitchDetector) {
+					hitchDetector->recordPhase(phase, begin, clockType::now());
+				}
+			}
+		};
+
+	private:
+		timePointType epoch{};
+		std::chrono::nanoseconds hitchThreshold{};
+		std::size_t framesAfterHitch{};
+		std::string dumpFilePrefix{};
+
+		std::vector<FrameRecord> history{};
+		FrameRecord currentFrame{};
+		bool hasPreviousFrame{};
+
+		//frame index the pending dump is centred on, dumped once enough frames
+		//after it are in
+		bool dumpPending{};
+		uint64_t pendingHitchFrameIndex{};
+		uint64_t hitchCount{};
+
+		//the render thread publishes its latest present through a seqlock, the
+		//loop thread folds it into the frame being recorded
+		std::atomic<uint32_t> presentSequence{ 0 };
+		std::atomic<int64_t> presentBeginNanoseconds{ 0 };
+		std::atomic<int64_t> presentEndNanoseconds{ 0 };
+		uint32_t lastFoldedPresentSequence{ 0 };
+
+		struct PendingDump {
+			uint64_t hitchFrameIndex{};
+			std::vector<FrameRecord> frames{};
+		};
+
+		std::thread dumpThread{};
+		std::mutex dumpMutex{};
+		std::condition_variable dumpCondition{};
+		std::deque<PendingDump> pendingDumps{};
+		bool stopRequested{};
+
+	public:
+		HitchDetector(
+			std::size_t historySize,
+			std::chrono::duration<double> hitchThreshold,
+			std::size_t framesAfterHitch,
+			const std::string& dumpFilePrefix
+		);
+
+		HitchDetector(const HitchDetector& other) = delete;
+		void operator=(const HitchDetector& other) = delete;
+
+		//writes out any dumps still queued
+		~HitchDetector();
+
+		void recordPhase(FramePhase phase, timePointType begin, timePointType end);
+
+		//safe to call from the render thread
+		void recordPresent(timePointType begin, timePointType end);
+
+		//closes the frame being recorded, and dumps history if a hitch is due
+		void endFrame(timePointType frameEnd);
+
+		//throws away the frame being recorded, for after the loop has been
+		//paused on purpose so the gap isn't taken as a hitch
+		void restartFrame(timePointType frameBegin);
+
+		uint64_t getHitchCount() const {
+			return hitchCount;
+		}
+
+		uint64_t getFrameCount() const {
+			return currentFrame.frameIndex;
+		}
+
+	private:
+		int64_t toNanoseconds(timePointType timePoint) const;
+		void foldPresent();
+		void addToPhase(FramePhase phase, int64_t beginNanoseconds, int64_t endNanoseconds);
+		const FrameRecord& getFrame(uint64_t frameIndex) const;
+		void queueDump(uint64_t hitchFrameIndex);
+		void dumpLoop();
+		void writeDump(const PendingDump& dump) const;
+	};
+}
\ No newline at end of file
@@ -4,8 +4,38 @@
 #include "BitmapDrawInstruction.h"
 #include "Point2.h"
 #include "Rectangle.h"
+#include "Span.h"
+
+#include <cmath>
+#include <algorithm>
 
 namespace wasp::graphics {
+	//one sprite of a batch, every instance of a batch shares the same bitmap
+	//d2d sprite batches can only take whole texel source rectangles, so every
+	//batch path draws from getPixelSourceRectangle to give the same result
+	struct SpriteInstance {
+		geometry::Point2 center{};
+		geometry::Rectangle sourceRectangle{};
+		float rotationDegrees{};
+		float scale{ 1.0f };
+		float opacity{ 1.0f };
+
+		//edges rounded to the nearest texel edge, never negative
+		geometry::Rectangle getPixelSourceRectangle() const {
+			const float left{ std::max(std::round(sourceRectangle.x), 0.0f) };
+			const float top{ std::max(std::round(sourceRectangle.y), 0.0f) };
+			const float right{ std::max(
+				std::round(sourceRectangle.x + sourceRectangle.width),
+				left
+			) };
+			const float bottom{ std::max(
+				std::round(sourceRectangle.y + sourceRectangle.height),
+				top
+			) };
+			return { left, top, right - left, bottom - top };
+		}
+	};
+
 	class IBitmapDrawer : public virtual IDrawer {
 	public:
 		virtual void drawBitmap(
@@ -18,5 +48,23 @@ namespace wasp::graphics {
 			const BitmapDrawInstruction& bitmapDrawInstruction,
 			const geometry::Rectangle& sourceRectangle
 		) = 0;
+
+		//drawers that can submit many sprites at once should override this
+		virtual void drawBitmapBatch(
+			const CComPtr<ID2D1Bitmap>& bitmap,
+			utility::Span<const SpriteInstance> instances
+		) {
+			BitmapDrawInstruction bitmapDrawInstruction{ bitmap };
+			for (const SpriteInstance& instance : instances) {
+				bitmapDrawInstruction.setRotationDegrees(instance.rotationDegrees);
+				bitmapDrawInstruction.setOpacity(instance.opacity);
+				bitmapDrawInstruction.setScale(instance.scale);
+				drawSubBitmap(
+					instance.center,
+					bitmapDrawInstruction,
+					instance.getPixelSourceRectangle()
+				);
+			}
+		}
 	};
 }
\ No newline at end of file
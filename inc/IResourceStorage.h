@@ -19,5 +19,10 @@ namespace wasp::resource {
         virtual void write(const std::wstring& id) const {
             throw UnsupportedOperationError{ "Error resource write unsupported" };
         };
+
+        //inserts between these are published together at the outermost end,
+        //so loading many resources doesn't copy the storage once per resource
+        virtual void beginWriteBatch() {}
+        virtual void endWriteBatch() {}
     };
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+namespace wasp::jobs {
+
+	//counts jobs still to finish, wait on it with JobSystem::wait
+	class JobCounter {
+	private:
+		std::atomic<uint32_t> pendingJobs{ 0 };
+
+		friend class JobSystem;
+
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter& other) = delete;
+		void operator=(const JobCounter& other) = delete;
+
+		bool isDone() const {
+			return pendingJobs.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	//a fixed pool of workers, each with its own deque
+	//a thread pushes to and pops from the back of its own deque, and steals from
+	//the front of the others' when it runs dry, so work spreads out without a
+	//single shared queue
+	//threads that aren't workers share the first deque, and help out with jobs
+	//while they wait on a counter
+	class JobSystem {
+	public:
+		using jobFunctionType = std::function<void()>;
+		using rangeFunctionType = std::function<void(std::size_t begin, std::size_t end)>;
+
+	private:
+		struct Job {
+			jobFunctionType function{};
+			JobCounter* counter{};
+		};
+
+		//deques are short lived and only locked for a push or pop, so a plain
+		//mutex is enough
+		struct JobQueue {
+			std::mutex mutex{};
+			std::deque<Job> jobs{};
+		};
+
+		std::vector<std::unique_ptr<JobQueue>> queues{};
+		std::vector<std::thread> workers{};
+
+		std::atomic<std::size_t> queuedJobCount{ 0 };
+		std::atomic<std::size_t> sleepingWorkerCount{ 0 };
+		std::atomic_bool running{ false };
+		std::mutex sleepMutex{};
+		std::condition_variable sleepCondition{};
+
+	public:
+		//defaults to a worker per core besides the calling thread
+		explicit JobSystem(std::size_t workerCount = getDefaultWorkerCount());
+
+		JobSystem(const JobSystem& other) = delete;
+		void operator=(const JobSystem& other) = delete;
+
+		//waits for the workers, which finish whatever job they are on
+		~JobSystem();
+
+		void run(JobCounter& counter, jobFunctionType job);
+
+		//splits [begin, end) into jobs of at most grainSize indices
+		//function is used by reference, so it has to outlive the counter
+		void parallelFor(
+			JobCounter& counter,
+			std::size_t begin,
+			std::size_t end,
+			std::size_t grainSize,
+			const rangeFunctionType& function
+		);
+
+		//blocking version, the calling thread takes part
+		void parallelFor(
+			std::size_t begin,
+			std::size_t end,
+			std::size_t grainSize,
+			const rangeFunctionType& function
+		);
+
+		//runs queued jobs until the counter reaches zero
+		void wait(const JobCounter& counter);
+
+		std::size_t getWorkerCount() const {
+			return workers.size();
+		}
+
+		//workers plus the thread that waits
+		std::size_t getThreadCount() const {
+			return workers.size() + 1;
+		}
+
+		static std::size_t getDefaultWorkerCount();
+
+	private:
+		void push(Job&& job);
+		bool popOrSteal(Job& job);
+		static void execute(Job& job);
+		void workerLoop(std::size_t queueIndex);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <ostream>
+#include <variant>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "SpscRingBuffer.h"
+#include "TscClock.h"
+
+//levels below this are compiled out, 0 is trace and 4 is error
+#ifndef WASP_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define WASP_LOG_MIN_LEVEL 0
+#else
+#define WASP_LOG_MIN_LEVEL 2
+#endif
+#endif
+
+//logging copies a fixed size record into a ring owned by the calling thread,
+//and a background thread formats and writes them, so the caller never waits
+//on the output stream
+//format strings and string arguments are stored as pointers, so they must be
+//literals or otherwise outlive the record
+//"{}" in the format is replaced by the next argument
+namespace wasp::log {
+
+	enum class Level : uint8_t { trace, debug, info, warning, error };
+
+	constexpr Level minimumLevel{ static_cast<Level>(WASP_LOG_MIN_LEVEL) };
+	constexpr std::size_t maxArguments{ 4 };
+	constexpr std::size_t recordsPerThread{ 1024 };
+
+	constexpr bool isEnabled(Level level) {
+		return level >= minimumLevel;
+	}
+
+	using Argument = std::variant<bool, char, int64_t, uint64_t, double, const char*>;
+
+	struct Record {
+		const char* format{};
+		time::TscClock::time_point time{};
+		uint32_t threadIndex{};
+		Level level{};
+		uint8_t argumentCount{};
+		std::array<Argument, maxArguments> arguments{};
+	};
+
+	//full rings drop records instead of blocking
+	struct ThreadBuffer {
+		utility::SpscRingBuffer<Record> records{ recordsPerThread };
+		std::atomic<uint64_t> droppedCount{ 0 };
+		uint32_t threadIndex{};
+	};
+
+	//starts the formatting thread, records made before this are kept
+	void start(std::ostream& outStream);
+	//writes out everything already logged and joins the formatting thread
+	void stop();
+	uint64_t getDroppedCount();
+
+	//makes this thread's buffer on its first log
+	ThreadBuffer& registerThread();
+
+	inline ThreadBuffer& getThreadBuffer() {
+		thread_local ThreadBuffer* threadBufferPointer{};
+		if (!threadBufferPointer) {
+			threadBufferPointer = &registerThread();
+		}
+		return *threadBufferPointer;
+	}
+
+	template <typename T>
+	Argument toArgument(const T& value) {
+		using valueType = std::decay_t<T>;
+		if constexpr (std::is_same_v<valueType, bool> || std::is_same_v<valueType, char>) {
+			return value;
+		}
+		else if constexpr (std::is_integral_v<valueType> && std::is_signed_v<valueType>) {
+			return static_cast<int64_t>(value);
+		}
+		else if constexpr (std::is_integral_v<valueType>) {
+			return static_cast<uint64_t>(value);
+		}
+		else if constexpr (std::is_enum_v<valueType>) {
+			return static_cast<int64_t>(value);
+		}
+		else if constexpr (std::is_floating_point_v<valueType>) {
+			return static_cast<double>(value);
+		}
+		else {
+			static_assert(
+				std::is_convertible_v<const T&, const char*>,
+				"log arguments must be numbers or string literals"
+			);
+			return static_cast<const char*>(value);
+		}
+	}
+
+	template <Level level, typename... Args>
+	void write(const char* format, const Args&... args) {
+		if constexpr (isEnabled(level)) {
+			static_assert(sizeof...(Args) <= maxArguments, "too many log arguments");
+			ThreadBuffer& threadBuffer{ getThreadBuffer() };
+			Record record{};
+			record.format = format;
+			record.time = time::TscClock::now();
+			record.threadIndex = threadBuffer.threadIndex;
+			record.level = level;
+			record.argumentCount = static_cast<uint8_t>(sizeof...(Args));
+			[[maybe_unused]] std::size_t index{ 0 };
+			((record.arguments[index++] = toArgument(args)), ...);
+			if (!threadBuffer.records.push(record)) {
+				threadBuffer.droppedCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template <typename... Args>
+	void trace(const char* format, const Args&... args) {
+		write<Level::trace>(format, args...);
+	}
+
+	template <typename... Args>
+	void debug(const char* format, const Args&... args) {
+		write<Level::debug>(format, args...);
+	}
+
+	template <typename... Args>
+	void info(const char* format, const Args&... args) {
+		write<Level::info>(format, args...);
+	}
+
+	template <typename... Args>
+	void warning(const char* format, const Args&... args) {
+		write<Level::warning>(format, args...);
+	}
+
+	template <typename... Args>
+	void error(const char* format, const Args&... args) {
+		write<Level::error>(format, args...);
+	}
+}
\ No newline at end of file
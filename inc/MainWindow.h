@@ -9,10 +9,13 @@ namespace wasp::window {
     class MainWindow : public BaseWindow<MainWindow>{
     private:
         WindowPainter windowPainter{};
+        std::function<void()> paintCallback{};
+        std::function<void()> resizeCallback{};
         std::function<void()> destroyCallback{};
         std::function<void(WPARAM wParam, LPARAM lParam)> keyDownCallback{};
         std::function<void(WPARAM wParam, LPARAM lParam)> keyUpCallback{};
         std::function<void()> outOfFocusCallback{};
+        std::function<void()> inFocusCallback{};
 
     public:
         MainWindow() = default;
@@ -27,6 +30,15 @@ namespace wasp::window {
             return windowPainter;
         }
 
+        //when set, paints and resizes go here instead of to the painter
+        void setPaintCallback(const std::function<void()>& paintCallback) {
+            this->paintCallback = paintCallback;
+        }
+
+        void setResizeCallback(const std::function<void()>& resizeCallback) {
+            this->resizeCallback = resizeCallback;
+        }
+
         void setDestroyCallback(const std::function<void()>& destroyCallback) {
             this->destroyCallback = destroyCallback;
         }
@@ -46,5 +58,9 @@ namespace wasp::window {
         void setOutOfFocusCallback(const std::function<void()>& outOfFocusCallback) {
             this->outOfFocusCallback = outOfFocusCallback;
         }
+
+        void setInFocusCallback(const std::function<void()>& inFocusCallback) {
+            this->inFocusCallback = inFocusCallback;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "framework.h"
+#include <string>
+#include <cstddef>
+
+#include "Span.h"
+
+namespace wasp::file {
+	//read only view of an entire file, pages are brought in by the OS on demand
+	class MappedFile {
+	private:
+		HANDLE fileHandle{ INVALID_HANDLE_VALUE };
+		HANDLE mappingHandle{};
+		const std::byte* viewPointer{};
+		std::size_t fileSize{};
+
+	public:
+		MappedFile() = default;
+		MappedFile(const std::wstring& fileName);
+
+		MappedFile(const MappedFile& other) = delete;
+		void operator=(const MappedFile& other) = delete;
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		~MappedFile();
+
+		utility::Span<const std::byte> getBytes() const {
+			return { viewPointer, fileSize };
+		}
+
+		std::size_t size() const {
+			return fileSize;
+		}
+
+		bool isOpen() const {
+			return viewPointer != nullptr;
+		}
+
+	private:
+		void close() noexcept;
+	};
+}
\ No newline at end of file
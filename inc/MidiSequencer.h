@@ -3,12 +3,12 @@
 #include "framework.h"
 
 #include "MidiSequence.h"
+#include "TimerService.h"
 
 namespace wasp::sound::midi {
 	class MidiSequencer { //todo: inherit IMidiSequencer
 	private:
 		HMIDIOUT midiOutHandle{};
-		LARGE_INTEGER performanceFrequency{};
 
 	public:
 		MidiSequencer();
@@ -18,7 +18,8 @@ namespace wasp::sound::midi {
 
 		~MidiSequencer();
 
-		void test(MidiSequence& midiSequence);
+		//plays on the calling thread, waiting between events through timerService
+		void test(MidiSequence& midiSequence, time::TimerService& timerService);
 
 	private:
 		void outputMidiEvent(
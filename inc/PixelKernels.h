@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+//row kernels over 32 bit premultiplied 0xAARRGGBB pixels (pbgra in memory)
+//every kernel has a scalar reference version, and sse2 and avx2 versions that
+//give exactly the same output; the fastest one the cpu supports is picked the
+//first time getKernels() is called
+//amounts are 0 to 256, where 256 leaves a pixel unchanged
+namespace wasp::graphics::pixel {
+
+	enum class InstructionSet { scalar, sse2, avx2 };
+
+	//positions and steps are 16.16 fixed point so every version walks the span
+	//the same way
+	constexpr int32_t fixedOne{ 1 << 16 };
+
+	inline int32_t toFixed(float value) {
+		return static_cast<int32_t>(std::lround(value * fixedOne));
+	}
+
+	//the region samplers read from, pixels outside it come out transparent
+	//and bilinear filtering clamps to its edges
+	struct SourceImage {
+		const uint32_t* pixels{};
+		int stride{};	//in pixels
+		int left{};
+		int top{};
+		int right{};	//exclusive
+		int bottom{};	//exclusive
+	};
+
+	//source position of the first pixel's center and the change per pixel
+	struct AffineSpan {
+		int32_t u{};
+		int32_t v{};
+		int32_t stepU{};
+		int32_t stepV{};
+	};
+
+	struct Kernels {
+		InstructionSet instructionSet{};
+
+		void (*fill)(uint32_t* destination, std::size_t count, uint32_t color){};
+
+		//destination = source * amount
+		void (*modulate)(
+			uint32_t* destination,
+			const uint32_t* source,
+			std::size_t count,
+			uint32_t amount
+		){};
+
+		//destination = source over destination, channels saturate
+		void (*blend)(uint32_t* destination, const uint32_t* source, std::size_t count){};
+
+		void (*sampleNearest)(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		){};
+
+		void (*sampleBilinear)(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		){};
+	};
+
+	bool isSupported(InstructionSet instructionSet);
+	InstructionSet getBestInstructionSet();
+
+	//throws if the cpu doesn't support the set
+	const Kernels& getKernels(InstructionSet instructionSet);
+	const Kernels& getKernels();
+
+	const char* getName(InstructionSet instructionSet);
+
+	inline void fill(uint32_t* destination, std::size_t count, uint32_t color) {
+		getKernels().fill(destination, count, color);
+	}
+
+	inline void modulate(
+		uint32_t* destination,
+		const uint32_t* source,
+		std::size_t count,
+		uint32_t amount
+	) {
+		getKernels().modulate(destination, source, count, amount);
+	}
+
+	inline void blend(uint32_t* destination, const uint32_t* source, std::size_t count) {
+		getKernels().blend(destination, source, count);
+	}
+
+	inline void sampleNearest(
+		uint32_t* destination,
+		std::size_t count,
+		const SourceImage& source,
+		const AffineSpan& span
+	) {
+		getKernels().sampleNearest(destination, count, source, span);
+	}
+
+	inline void sampleBilinear(
+		uint32_t* destination,
+		std::size_t count,
+		const SourceImage& source,
+		const AffineSpan& span
+	) {
+		getKernels().sampleBilinear(destination, count, source, span);
+	}
+}
\ No newline at end of file
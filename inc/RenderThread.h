@@ -0,0 +1,94 @@
+#pragma once
+
+#include "framework.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "WindowPainter.h"
+#include "DrawList.h"
+#include "TripleBuffer.h"
+#include "HitchDetector.h"
+
+namespace wasp::window {
+	//owns all drawing and presenting through the window painter
+	//the update thread records a frame into getDrawList() and submits it, the
+	//render thread replays the newest submitted list; frames the render thread
+	//couldn't get to are skipped rather than queued
+	class RenderThread {
+	private:
+		static constexpr double smoothing{ 0.9 };
+
+		WindowPainter& windowPainter;
+		HWND windowHandle{};
+
+		utility::TripleBuffer<graphics::DrawList> drawLists{};
+
+		std::thread thread{};
+		std::mutex wakeMutex{};
+		std::condition_variable wakeCondition{};
+		bool frameSubmitted{};
+		//set by the window thread, applied between frames
+		bool presentRequested{};
+		bool resizeRequested{};
+		bool stopRequested{};
+
+		std::atomic<uint64_t> framesRendered{ 0 };
+		std::atomic<double> averageFrameSeconds{ 0.0 };
+
+		debug::HitchDetector* hitchDetector{};
+		std::function<void()> betweenFramesCallback{};
+
+	public:
+		RenderThread(WindowPainter& windowPainter, HWND windowHandle)
+			: windowPainter{ windowPainter }
+			, windowHandle{ windowHandle } {
+		}
+
+		RenderThread(const RenderThread& other) = delete;
+		void operator=(const RenderThread& other) = delete;
+
+		~RenderThread();
+
+		//set before start, presents are recorded into it; may be null
+		void setHitchDetector(debug::HitchDetector* hitchDetector) {
+			this->hitchDetector = hitchDetector;
+		}
+
+		//set before start, called on the render thread before each frame for
+		//work that has to happen there, such as making d2d bitmaps
+		void setBetweenFramesCallback(const std::function<void()>& betweenFramesCallback) {
+			this->betweenFramesCallback = betweenFramesCallback;
+		}
+
+		void start();
+		void stop();
+
+		//update thread only, valid until the next submit
+		graphics::DrawList& getDrawList() {
+			return drawLists.getWriteBuffer();
+		}
+
+		void submit();
+
+		//any thread; the window thread must not touch the painter itself once
+		//the render thread has started
+		void requestPresent();
+		void requestResize();
+
+		uint64_t getFramesRendered() const {
+			return framesRendered.load(std::memory_order_relaxed);
+		}
+
+		double getAverageFrameSeconds() const {
+			return averageFrameSeconds.load(std::memory_order_relaxed);
+		}
+
+	private:
+		void renderLoop();
+		void renderFrame(const graphics::DrawList& drawList);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace wasp::sound {
+	//polyphase sample rate converter for interleaved float audio
+	//the rate ratio is reduced to upFactor / downFactor and one filter phase is
+	//precomputed for each of the upFactor possible output positions
+	class Resampler {
+	private:
+		static constexpr int defaultTapsPerPhase{ 32 };
+		//fraction of the lower nyquist frequency that is passed unattenuated
+		static constexpr double passband{ 0.9 };
+		static constexpr double kaiserBeta{ 8.0 };
+		//compact the input buffer once this many frames have been consumed
+		static constexpr std::size_t compactThreshold{ 4096 };
+
+		int channels{};
+		uint32_t upFactor{};
+		uint32_t downFactor{};
+		int tapsPerPhase{};
+
+		//upFactor rows of tapsPerPhase coefficients, each row reversed so it can
+		//be multiplied against input samples in increasing order
+		std::vector<float> filterBank{};
+		//one deinterleaved input buffer per channel
+		std::vector<std::vector<float>> channelInputs{};
+
+		std::size_t inputPosition{};	//start of the next filter window
+		uint32_t phase{};
+
+	public:
+		Resampler(
+			uint32_t inputRate,
+			uint32_t outputRate,
+			int channels,
+			int tapsPerPhase = defaultTapsPerPhase
+		);
+
+		void push(const float* interleavedInput, std::size_t frames);
+
+		//returns the number of frames written, limited by the input pushed so far
+		std::size_t pull(float* interleavedOutput, std::size_t maxFrames);
+
+		std::size_t getAvailableFrames() const;
+
+		//input frames of delay introduced by the filter
+		double getLatencyFrames() const {
+			//center of the prototype filter, measured in input samples
+			return (static_cast<double>(upFactor) * tapsPerPhase - 1) / (2.0 * upFactor);
+		}
+
+		void reset();
+
+		int getChannels() const {
+			return channels;
+		}
+
+	private:
+		void buildFilterBank();
+		void compactInputs();
+		void advance();
+	};
+}
\ No newline at end of file
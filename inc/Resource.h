@@ -18,7 +18,7 @@ namespace wasp::resource {
 			const std::wstring& id,
 			const ResourceOriginVariant& origin
 		)
-			: ResourceBase{ id, false }
+			: ResourceBase{ id }
 			, origin{ origin } {
 		}
 
@@ -27,7 +27,7 @@ namespace wasp::resource {
 			const ResourceOriginVariant& origin,
 			std::shared_ptr<T> dataPointer
 		)
-			: ResourceBase{ id, true }
+			: ResourceBase{ id }
 			, origin{ origin }
 			, dataPointer{ dataPointer } {
 		}
@@ -35,19 +35,33 @@ namespace wasp::resource {
 		const ResourceOriginVariant& getOrigin() const {
 			return origin;
 		}
+		//data can be unloaded on a loader thread while it is being read
 		std::shared_ptr<T> getDataPointerCopy() {
-			return dataPointer;
+			return std::atomic_load(&dataPointer);
 		}
 		const std::shared_ptr<const T> getDataPointerCopy() const {
-			return dataPointer;
+			return std::atomic_load(&dataPointer);
 		}
 		void setData(std::shared_ptr<T> dataPointer) {
-			this->dataPointer = dataPointer;
-			loaded = static_cast<bool>(dataPointer);
+			std::atomic_store(&this->dataPointer, dataPointer);
+		}
+		//sets the data only if it is still expected, so an update made from a
+		//copy can't bring back data that was unloaded meanwhile
+		bool compareAndSetData(
+			std::shared_ptr<T>& expected, 
+			std::shared_ptr<T> dataPointer
+		) {
+			return std::atomic_compare_exchange_strong(
+				&this->dataPointer, 
+				&expected, 
+				dataPointer
+			);
 		}
 		void unloadData() {
-			dataPointer = nullptr;
-			loaded = false;
+			std::atomic_store(&dataPointer, std::shared_ptr<T>{});
+		}
+		bool isLoaded() const override {
+			return static_cast<bool>(std::atomic_load(&dataPointer));
 		}
 	};
 }
\ No newline at end of file
@@ -12,14 +12,12 @@ namespace wasp::resource {
         ResourceBase* parentPointer{}; //assume parents don't outlive children
         IResourceStorage* storagePointer{}; //assume resources don't outlive storages
         std::wstring id{};
-        bool loaded{};
 
     public:
-        ResourceBase(const std::wstring& id, bool loaded)
+        ResourceBase(const std::wstring& id)
             : parentPointer{ nullptr }
             , storagePointer{ nullptr }
-            , id{ id }
-            , loaded{ loaded } {
+            , id{ id } {
         }
 
         virtual ~ResourceBase() {
@@ -41,6 +39,14 @@ namespace wasp::resource {
             this->parentPointer = parentPointer;
         }
 
+        //removes this from its parent's children now rather than on destruction
+        void detachFromParent() {
+            if (parentPointer) {
+                parentPointer->removeChild(this);
+                parentPointer = nullptr;
+            }
+        }
+
         void setStoragePointer(IResourceStorage* storagePointer) {
             this->storagePointer = storagePointer;
         }
@@ -49,9 +55,9 @@ namespace wasp::resource {
             return id;
         }
 
-        bool isLoaded() const {
-            return loaded;
-        }
+        //read from the data itself, so it can't disagree with what a reader
+        //on another thread gets
+        virtual bool isLoaded() const = 0;
 
     protected:
         virtual void removeChild(ResourceBase* child) {}
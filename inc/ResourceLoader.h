@@ -2,10 +2,12 @@
 
 #include <unordered_map>
 #include <array>
+#include <vector>
 #include <memory>
 
 #include "FileLoadable.h"
 #include "ManifestLoadable.h"
+#include "IResourceStorage.h"
 
 namespace wasp::resource {
 
@@ -13,6 +15,7 @@ namespace wasp::resource {
 	private:
 		std::unordered_map<std::wstring, FileLoadable*> fileExtensionMap{};
 		std::unordered_map<std::wstring, ManifestLoadable*> manifestPrefixMap{};
+		std::vector<IResourceStorage*> storagePointers{};
 
 	public:
 		template <std::size_t NUM_LOADABLES>
@@ -20,6 +23,10 @@ namespace wasp::resource {
 			const std::array<Loadable*, NUM_LOADABLES>& loadables
 		) {
 			for (Loadable* loadable : loadables) {
+				IResourceStorage* storagePointer{ asResourceStorage(loadable) };
+				if (storagePointer) {
+					storagePointers.push_back(storagePointer);
+				}
 				if (loadable->isFileLoadable()) {
 					FileLoadable* fileLoadable{ asFileLoadable(loadable) };
 					for (auto& fileExtension : 
@@ -42,12 +49,42 @@ namespace wasp::resource {
 			}
 		}
 
+		//each load is one write batch on every storage, so a manifest or
+		//directory of any size is published once per storage; loads it starts
+		//join the same batch
 		ResourceBase* loadFile(const FileOrigin& fileOrigin) const;
 		ResourceBase* loadManifestEntry(
 			const ManifestOrigin& manifestOrigin
 		) const;
 
 	private:
+		//ends the batches when it goes out of scope, a failed load included
+		class WriteBatch {
+		private:
+			const std::vector<IResourceStorage*>& storagePointers;
+
+		public:
+			WriteBatch(const std::vector<IResourceStorage*>& storagePointers)
+				: storagePointers{ storagePointers } {
+				for (IResourceStorage* storagePointer : storagePointers) {
+					storagePointer->beginWriteBatch();
+				}
+			}
+
+			~WriteBatch() {
+				for (IResourceStorage* storagePointer : storagePointers) {
+					storagePointer->endWriteBatch();
+				}
+			}
+
+			WriteBatch(const WriteBatch& other) = delete;
+			void operator=(const WriteBatch& other) = delete;
+		};
+
+		IResourceStorage* asResourceStorage(Loadable* loadable) const {
+			return dynamic_cast<IResourceStorage*>(loadable);
+		}
+
 		FileLoadable* asFileLoadable(Loadable* loadable) const {
 			return dynamic_cast<FileLoadable*>(loadable);
 		}
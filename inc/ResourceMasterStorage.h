@@ -3,11 +3,13 @@
 #include "DirectoryStorage.h"
 #include "ManifestStorage.h"
 #include "BitmapStorage.h"
+#include "WaveStorage.h"
 
 namespace wasp::game::gameresource {
 	struct ResourceMasterStorage {
 		DirectoryStorage directoryStorage;
 		ManifestStorage manifestStorage;
 		BitmapStorage bitmapStorage;
+		WaveStorage waveStorage;
 	};
 }
\ No newline at end of file
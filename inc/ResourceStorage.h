@@ -6,6 +6,8 @@
 #include <unordered_map>
 #include <algorithm>
 #include <functional>
+#include <mutex>
+#include <stdexcept>
 
 #include "Resource.h"
 #include "IResourceStorage.h"
@@ -14,61 +16,178 @@
 
 namespace wasp::resource {
 
+    //readers take a snapshot of the map and never see it change under them,
+    //writers copy the map, change the copy and swap it in
+    //so loads and reloads can happen off the main thread while get is called
+    //inserts in a write batch go into one copy published when the batch ends,
+    //inserts from other threads meanwhile wait for that too
     template <typename T>
     class ResourceStorage : public IResourceStorage{
         using ResourceMap = 
             std::unordered_map<std::wstring, std::shared_ptr<Resource<T>>>;
 
+    private:
+        //only touched through atomic_load and atomic_store
+        std::shared_ptr<const ResourceMap> resourceMapPointer{ 
+            std::make_shared<const ResourceMap>()
+        };
+        //writers still go one at a time, readers never take it
+        std::mutex writeMutex{};
+        //the unpublished copy writers change, only non null inside a batch;
+        //guarded by writeMutex like batchDepth
+        std::shared_ptr<ResourceMap> writeMapPointer{};
+        int batchDepth{};
+
     protected:
-        ResourceMap resourceMap{};
         ResourceLoader* resourceLoaderPointer{}; //for reloading? is this dumb?
 
     public:
         ResourceStorage() = default;
         virtual ~ResourceStorage() = default;
 
+        ResourceStorage(const ResourceStorage& other) = delete;
+        void operator=(const ResourceStorage& other) = delete;
+
         void unload(const std::wstring& id) override {
-            auto found{ resourceMap.find(id) };
-            if (found != resourceMap.end()) {
-                Resource<T>& resource{
-                    *(std::get<1>(*found))
-                };
-
-                if (resource.isLoaded()) {
-                    resource.unloadData();
-                }
+            std::shared_ptr<Resource<T>> resourcePointer{ findResource(id) };
+            if (resourcePointer && resourcePointer->isLoaded()) {
+                resourcePointer->unloadData();
             }
         }
 
         void remove(const std::wstring& id) override {
-            //calls parent.removeChild in destructor
-            resourceMap.erase(id);
+            eraseResource(id);
         }
 
         virtual std::shared_ptr<T> get(const std::wstring& id) {
-            auto found{ resourceMap.find(id) };
-            if (found != resourceMap.end()) {
-                return std::get<1>(*found)->getDataPointerCopy();
+            std::shared_ptr<Resource<T>> resourcePointer{ findResource(id) };
+            if (resourcePointer) {
+                return resourcePointer->getDataPointerCopy();
             }
             else {
                 return nullptr;
             }
         }
 
+        void beginWriteBatch() override {
+            std::lock_guard<std::mutex> lock{ writeMutex };
+            ++batchDepth;
+        }
+
+        void endWriteBatch() override {
+            std::lock_guard<std::mutex> lock{ writeMutex };
+            --batchDepth;
+            if (batchDepth == 0 && writeMapPointer) {
+                publishWriteMap();
+            }
+        }
+
         void setLoader(ResourceLoader* resourceLoaderPointer) {
             this->resourceLoaderPointer = resourceLoaderPointer;
         }
 
+        //runs over a snapshot, resources added meanwhile are not seen
         void forEach(
             std::function<void(std::shared_ptr<Resource<T>>)> callBackFunction
         ) {
+            const std::shared_ptr<const ResourceMap> snapshot{ getSnapshot() };
             std::for_each(
-                resourceMap.begin(), 
-                resourceMap.end(), 
+                snapshot->begin(), 
+                snapshot->end(), 
                 [&](auto pairElement) {
                     callBackFunction(std::get<1>(pairElement));
                 }
             );
         }
+
+    protected:
+        std::shared_ptr<const ResourceMap> getSnapshot() const {
+            return std::atomic_load(&resourceMapPointer);
+        }
+
+        std::shared_ptr<Resource<T>> findResource(const std::wstring& id) const {
+            const std::shared_ptr<const ResourceMap> snapshot{ getSnapshot() };
+            auto found{ snapshot->find(id) };
+            if (found != snapshot->end()) {
+                return std::get<1>(*found);
+            }
+            return nullptr;
+        }
+
+        void insertResource(
+            const std::wstring& id, 
+            const std::shared_ptr<Resource<T>>& resourcePointer
+        ) {
+            std::lock_guard<std::mutex> lock{ writeMutex };
+            if (isInWriteMap(id)) {
+                throw std::runtime_error{ "Error loaded pre-existing id" };
+            }
+            getWriteMap().insert({ id, resourcePointer });
+            if (batchDepth == 0) {
+                publishWriteMap();
+            }
+        }
+
+        //readers see either the old resource or the new one, never neither
+        //published straight away even in a batch, along with the batch so far
+        void replaceResource(
+            const std::wstring& id,
+            const std::shared_ptr<Resource<T>>& resourcePointer
+        ) {
+            std::lock_guard<std::mutex> lock{ writeMutex };
+            std::shared_ptr<Resource<T>>& entry{ getWriteMap()[id] };
+            if (entry) {
+                entry->detachFromParent();
+            }
+            entry = resourcePointer;
+            publishWriteMap();
+        }
+
+        //published straight away like replaceResource
+        bool eraseResource(const std::wstring& id) {
+            std::lock_guard<std::mutex> lock{ writeMutex };
+            if (!isInWriteMap(id)) {
+                return false;
+            }
+            ResourceMap& newMap{ getWriteMap() };
+            auto found{ newMap.find(id) };
+            //readers can keep the resource alive past this point, so leave the
+            //parent now on the writing thread instead of in the destructor
+            std::get<1>(*found)->detachFromParent();
+            newMap.erase(found);
+            publishWriteMap();
+            return true;
+        }
+
+    private:
+        //the rest need writeMutex held
+
+        bool isInWriteMap(const std::wstring& id) const {
+            if (writeMapPointer) {
+                return writeMapPointer->find(id) != writeMapPointer->end();
+            }
+            const std::shared_ptr<const ResourceMap> snapshot{ getSnapshot() };
+            return snapshot->find(id) != snapshot->end();
+        }
+
+        //copies the published map on the first write since the last publish
+        ResourceMap& getWriteMap() {
+            if (!writeMapPointer) {
+                writeMapPointer = std::make_shared<ResourceMap>(*getSnapshot());
+            }
+            return *writeMapPointer;
+        }
+
+        void publishWriteMap() {
+            publish(std::move(writeMapPointer));
+            writeMapPointer = nullptr;
+        }
+
+        void publish(std::shared_ptr<ResourceMap>&& newMap) {
+            std::atomic_store(
+                &resourceMapPointer, 
+                std::shared_ptr<const ResourceMap>{ std::move(newMap) }
+            );
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "framework.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+#include "IBitmapDrawer.h"
+#include "ITextDrawer.h"
+#include "SoftwareRasterizer.h"
+
+namespace wasp::graphics {
+
+	//draws the same calls as WindowPainter, but on the cpu into a
+	//graphicsWidth by graphicsHeight framebuffer, for headless runs and
+	//comparing frames
+	//draw instructions only carry the d2d bitmap, so the pixels for each one
+	//have to be added first, copied from the wic source it was made from or
+	//given directly for bitmaps made from pixels, like atlas pages
+	class SoftwarePainter
+		: public IBitmapDrawer
+		, public ITextDrawer
+	{
+	private:
+		SoftwareRasterizer rasterizer;
+		std::unordered_map<ID2D1Bitmap*, SoftwareBitmap> bitmaps{};
+		std::string frameDumpPrefix{};
+		uint64_t frameIndex{};
+
+	public:
+		SoftwarePainter();
+
+		SoftwarePainter(const SoftwarePainter& other) = delete;
+		void operator=(const SoftwarePainter& other) = delete;
+
+		//wicBitmap has to be 32bpp premultiplied bgra, as BitmapConstructor makes
+		void addBitmap(
+			const CComPtr<ID2D1Bitmap>& d2dBitmap,
+			const CComPtr<IWICFormatConverter>& wicBitmap
+		);
+
+		void addBitmap(
+			const CComPtr<ID2D1Bitmap>& d2dBitmap,
+			SoftwareBitmap softwareBitmap
+		);
+
+		//empty prefix turns dumping off, otherwise each endDraw writes
+		//<prefix><frameIndex>.bmp
+		void setFrameDumpPrefix(const std::string& frameDumpPrefix) {
+			this->frameDumpPrefix = frameDumpPrefix;
+		}
+
+		const SoftwareRasterizer& getRasterizer() const {
+			return rasterizer;
+		}
+
+		uint64_t getFrameIndex() const {
+			return frameIndex;
+		}
+
+		void beginDraw() override;
+
+		void drawBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction
+		) override;
+
+		void drawSubBitmap(
+			const geometry::Point2 center,
+			const BitmapDrawInstruction& bitmapDrawInstruction,
+			const geometry::Rectangle& sourceRectangle
+		) override;
+
+		void drawBitmapBatch(
+			const CComPtr<ID2D1Bitmap>& bitmap,
+			utility::Span<const SpriteInstance> instances
+		) override;
+
+		void drawText(
+			const geometry::Point2 pos,
+			const std::wstring& text,
+			const std::pair<float, float> bounds
+		) override;
+
+		void endDraw() override;
+
+	private:
+		const SoftwareBitmap& getSoftwareBitmap(
+			const BitmapDrawInstruction& bitmapDrawInstruction
+		) const;
+		const SoftwareBitmap& getSoftwareBitmap(ID2D1Bitmap* d2dBitmap) const;
+	};
+}
\ No newline at end of file
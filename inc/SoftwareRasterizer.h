@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "Point2.h"
+#include "Rectangle.h"
+
+namespace wasp::graphics {
+
+	//pixels are 32 bit premultiplied 0xAARRGGBB, so bytes in memory are in the
+	//same BGRA order as d2d and wic use
+	struct SoftwareBitmap {
+		int width{};
+		int height{};
+		std::vector<uint32_t> pixels{};
+	};
+
+	//draws bitmaps and text into a framebuffer on the cpu, with no platform
+	//dependencies so it can run headless and be compared frame by frame
+	//bitmaps are placed by their center, scaled, then rotated clockwise about
+	//the center, and sampled with bilinear filtering
+	//rows go through the pixel kernels, so output is the same whichever
+	//instruction set they run on
+	class SoftwareRasterizer {
+	public:
+		static constexpr int glyphWidth{ 6 };	//5 wide plus spacing
+		static constexpr int glyphHeight{ 10 };	//7 high plus descender and spacing
+
+	private:
+		int width{};
+		int height{};
+		std::vector<uint32_t> pixels{};
+		std::vector<uint32_t> rowBuffer{};	//sampled pixels before blending
+
+	public:
+		SoftwareRasterizer(int width, int height);
+
+		void clear(uint32_t color);
+
+		void drawBitmap(
+			const SoftwareBitmap& bitmap,
+			const geometry::Point2 center,
+			const geometry::Rectangle& sourceRectangle,
+			float rotationDegrees,
+			float scale,
+			float opacity
+		);
+
+		//fixed 5x7 font, characters outside ascii are drawn as '?'
+		//text wraps to the bounds width and is cut off at the bounds height
+		void drawText(
+			const geometry::Point2 pos,
+			const std::wstring& text,
+			const std::pair<float, float> bounds,
+			uint32_t color
+		);
+
+		//32bpp top down .bmp
+		void writeBitmapFile(const std::string& fileName) const;
+
+		int getWidth() const {
+			return width;
+		}
+
+		int getHeight() const {
+			return height;
+		}
+
+		const std::vector<uint32_t>& getPixels() const {
+			return pixels;
+		}
+
+		static uint32_t makeOpaqueColor(int rgb) {
+			return 0xFF000000u | (static_cast<uint32_t>(rgb) & 0x00FFFFFFu);
+		}
+
+	private:
+		void copyUnscaled(
+			const SoftwareBitmap& bitmap,
+			int left,
+			int top,
+			int sourceX,
+			int sourceY,
+			int copyWidth,
+			int copyHeight,
+			uint32_t opacity
+		);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+//std::span is c++20, we build against c++17
+namespace wasp::utility {
+	template <typename T>
+	class Span {
+	private:
+		T* dataPointer{};
+		std::size_t count{};
+
+	public:
+		Span() = default;
+		Span(T* dataPointer, std::size_t count)
+			: dataPointer{ dataPointer }
+			, count{ count } {
+		}
+
+		template <std::size_t SIZE>
+		Span(T(&array)[SIZE])
+			: dataPointer{ array }
+			, count{ SIZE } {
+		}
+
+		//containers with contiguous storage e.g. vector and array
+		template <typename Container, typename = decltype(
+			std::declval<Container&>().data(), std::declval<Container&>().size()
+		)>
+		Span(Container& container)
+			: dataPointer{ container.data() }
+			, count{ container.size() } {
+		}
+
+		T* data() const {
+			return dataPointer;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		std::size_t sizeBytes() const {
+			return count * sizeof(T);
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+
+		T* begin() const {
+			return dataPointer;
+		}
+
+		T* end() const {
+			return dataPointer + count;
+		}
+
+		T& operator[](std::size_t index) const {
+			return dataPointer[index];
+		}
+
+		Span subspan(std::size_t offset, std::size_t subCount) const {
+			if (offset > count || subCount > count - offset) {
+				throw std::out_of_range{ "Error subspan out of range" };
+			}
+			return { dataPointer + offset, subCount };
+		}
+	};
+}
\ No newline at end of file
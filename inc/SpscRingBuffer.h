@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+namespace wasp::utility {
+	//lock free ring buffer for exactly one producer thread and one consumer thread
+	//capacity is fixed at construction and rounded up to a power of 2
+	template <typename T>
+	class SpscRingBuffer {
+	private:
+		//keep the indices on separate cache lines so the threads don't fight
+		static constexpr std::size_t cacheLineSize{ 64 };
+
+		std::vector<T> buffer{};
+		std::size_t mask{};
+		alignas(cacheLineSize) std::atomic<std::size_t> writeIndex{ 0 };
+		alignas(cacheLineSize) std::atomic<std::size_t> readIndex{ 0 };
+
+	public:
+		explicit SpscRingBuffer(std::size_t minimumCapacity) {
+			if (minimumCapacity == 0) {
+				throw std::invalid_argument{ "Error ring buffer capacity 0" };
+			}
+			std::size_t capacity{ 1 };
+			while (capacity < minimumCapacity) {
+				capacity <<= 1;
+			}
+			buffer.resize(capacity);
+			mask = capacity - 1;
+		}
+
+		SpscRingBuffer(const SpscRingBuffer& other) = delete;
+		void operator=(const SpscRingBuffer& other) = delete;
+
+		std::size_t capacity() const {
+			return buffer.size();
+		}
+
+		//approximate when called from a third thread
+		std::size_t size() const {
+			return writeIndex.load(std::memory_order_acquire)
+				- readIndex.load(std::memory_order_acquire);
+		}
+
+		std::size_t freeSpace() const {
+			return capacity() - size();
+		}
+
+		//producer only, returns the number of elements actually written
+		std::size_t write(const T* source, std::size_t count) {
+			const std::size_t write{ writeIndex.load(std::memory_order_relaxed) };
+			const std::size_t read{ readIndex.load(std::memory_order_acquire) };
+			count = std::min(count, capacity() - (write - read));
+
+			const std::size_t start{ write & mask };
+			const std::size_t firstPart{ std::min(count, capacity() - start) };
+			std::copy(source, source + firstPart, buffer.begin() + start);
+			std::copy(source + firstPart, source + count, buffer.begin());
+
+			writeIndex.store(write + count, std::memory_order_release);
+			return count;
+		}
+
+		//producer only, single element version of write
+		bool push(const T& value) {
+			const std::size_t write{ writeIndex.load(std::memory_order_relaxed) };
+			if (write - readIndex.load(std::memory_order_acquire) == capacity()) {
+				return false;
+			}
+			buffer[write & mask] = value;
+			writeIndex.store(write + 1, std::memory_order_release);
+			return true;
+		}
+
+		//consumer only, returns the number of elements actually read
+		std::size_t read(T* destination, std::size_t count) {
+			const std::size_t read{ readIndex.load(std::memory_order_relaxed) };
+			const std::size_t write{ writeIndex.load(std::memory_order_acquire) };
+			count = std::min(count, write - read);
+
+			const std::size_t start{ read & mask };
+			const std::size_t firstPart{ std::min(count, capacity() - start) };
+			auto startIter{ buffer.begin() + start };
+			std::copy(startIter, startIter + firstPart, destination);
+			std::copy(
+				buffer.begin(), 
+				buffer.begin() + (count - firstPart), 
+				destination + firstPart
+			);
+
+			readIndex.store(read + count, std::memory_order_release);
+			return count;
+		}
+	};
+}
\ No newline at end of file
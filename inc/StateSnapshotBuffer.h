@@ -0,0 +1,50 @@
+#pragma once
+
+#include "TripleBuffer.h"
+
+namespace wasp::game {
+
+	template <typename T>
+	struct StateSnapshot {
+		T previous{};
+		T current{};
+	};
+
+	//keeps the last two simulation states so drawing can interpolate between
+	//them with the game loop's alpha; the update side never waits on drawing
+	template <typename T>
+	class StateSnapshotBuffer {
+	private:
+		utility::TripleBuffer<StateSnapshot<T>> tripleBuffer{};
+		T lastPublished{};
+
+	public:
+		StateSnapshotBuffer() = default;
+		explicit StateSnapshotBuffer(const T& initialState) {
+			publish(initialState);
+			publish(initialState);
+		}
+
+		//update side, call once at the end of each update
+		void publish(const T& state) {
+			StateSnapshot<T>& snapshot{ tripleBuffer.getWriteBuffer() };
+			snapshot.previous = lastPublished;
+			snapshot.current = state;
+			lastPublished = state;
+			tripleBuffer.publish();
+		}
+
+		//draw side, the returned reference stays valid until the next call
+		const StateSnapshot<T>& acquire() {
+			tripleBuffer.acquire();
+			return tripleBuffer.getReadBuffer();
+		}
+
+		//lerpFunction(previous, current, alpha) -> T
+		template <typename LerpFunction>
+		T interpolate(double alpha, LerpFunction lerpFunction) {
+			const StateSnapshot<T>& snapshot{ acquire() };
+			return lerpFunction(snapshot.previous, snapshot.current, alpha);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace wasp::game::gameloop {
+
+	//ticks subsystems that each run at their own fixed rate on one shared
+	//timeline, measured from when the loop started
+	//ticks are ordered by due time, ties by registration order, so a run is
+	//the same every time for the same timeline
+	//due times come from the tick index rather than adding up a period, so
+	//rates that don't divide a second evenly don't drift
+	class SubsystemScheduler {
+	public:
+		using tickFunctionType = std::function<void()>;
+
+	private:
+		using nanosecondsType = std::chrono::nanoseconds;
+
+		static constexpr int64_t nanosecondsPerSecond{ 1'000'000'000 };
+
+		struct Subsystem {
+			std::string name{};
+			int ticksPerSecond{};
+			nanosecondsType phaseOffset{};
+			tickFunctionType tickFunction{};
+			uint64_t scheduleIndex{};	//ticks since the timeline began
+			nanosecondsType nextDueTime{};
+			uint64_t tickCount{};		//ticks over the subsystem's lifetime
+		};
+
+		std::vector<Subsystem> subsystems{};
+
+	public:
+		SubsystemScheduler() = default;
+
+		//phase is a fraction of the subsystem's own period, use it to keep
+		//expensive low rate subsystems from landing on the same tick
+		//returns an index for the getters
+		std::size_t addSubsystem(
+			const std::string& name,
+			int ticksPerSecond,
+			double phase,
+			const tickFunctionType& tickFunction
+		);
+
+		//runs every tick due before timelineLimit, returns how many ran
+		uint64_t runUntil(nanosecondsType timelineLimit);
+
+		//starts the timeline again from 0, keeping the tick counts
+		void restart();
+
+		//nanoseconds::max() if there are no subsystems
+		nanosecondsType getNextDueTime() const;
+
+		bool empty() const {
+			return subsystems.empty();
+		}
+
+		std::size_t size() const {
+			return subsystems.size();
+		}
+
+		const std::string& getName(std::size_t index) const {
+			return subsystems.at(index).name;
+		}
+
+		uint64_t getTickCount(std::size_t index) const {
+			return subsystems.at(index).tickCount;
+		}
+
+	private:
+		static nanosecondsType calcDueTime(const Subsystem& subsystem);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "JobSystem.h"
+#include "TscClock.h"
+
+namespace wasp::jobs {
+
+	using TaskId = std::size_t;
+
+	struct CriticalPath {
+		std::vector<TaskId> tasks{};	//first to last
+		double seconds{};
+	};
+
+	//frame work split into tasks that declare which resources they read and
+	//write; a task waits for the last writer of anything it touches, and a
+	//writer also waits for the readers since that write, so the result is the
+	//same as running the tasks one by one in the order they were added
+	//built once, then run every frame on a job system with independent tasks
+	//in parallel
+	class TaskGraph {
+	public:
+		using taskFunctionType = std::function<void()>;
+
+	private:
+		using clockType = time::TscClock;
+
+		struct Task {
+			std::string name{};
+			std::vector<std::string> reads{};
+			std::vector<std::string> writes{};
+			taskFunctionType function{};
+
+			std::vector<TaskId> predecessors{};
+			std::vector<TaskId> successors{};
+			std::atomic<std::size_t> remainingPredecessors{ 0 };
+
+			clockType::time_point begin{};
+			clockType::time_point end{};
+		};
+
+		//tasks hold an atomic so they can't live in the vector directly
+		std::vector<std::unique_ptr<Task>> tasks{};
+		std::vector<TaskId> rootTasks{};
+		bool built{};
+
+		//kept between frames so working out the critical path doesn't allocate
+		std::vector<double> pathSeconds{};
+		std::vector<TaskId> pathPrevious{};
+		CriticalPath criticalPath{};
+
+	public:
+		TaskGraph() = default;
+
+		TaskGraph(const TaskGraph& other) = delete;
+		void operator=(const TaskGraph& other) = delete;
+
+		TaskId addTask(
+			const std::string& name,
+			const std::vector<std::string>& reads,
+			const std::vector<std::string>& writes,
+			const taskFunctionType& function
+		);
+
+		//works out the dependencies, no tasks can be added after
+		void build();
+
+		//runs every task once and returns when all are done, the calling thread
+		//takes part
+		void run(JobSystem& jobSystem);
+
+		//from the last run, using measured task times
+		const CriticalPath& getCriticalPath() const {
+			return criticalPath;
+		}
+
+		//e.g. "input 0.012ms -> movement 0.430ms -> collision 1.200ms"
+		std::string formatCriticalPath() const;
+
+		const std::string& getTaskName(TaskId id) const {
+			return tasks.at(id)->name;
+		}
+
+		const std::vector<TaskId>& getPredecessors(TaskId id) const {
+			return tasks.at(id)->predecessors;
+		}
+
+		double getTaskSeconds(TaskId id) const;
+
+		std::size_t size() const {
+			return tasks.size();
+		}
+
+	private:
+		void schedule(JobSystem& jobSystem, JobCounter& counter, TaskId id);
+		void runTask(JobSystem& jobSystem, JobCounter& counter, TaskId id);
+		void updateCriticalPath();
+	};
+}
\ No newline at end of file
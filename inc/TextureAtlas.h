@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Rectangle.h"
+#include "SoftwareRasterizer.h"	//SoftwareBitmap
+#include "Span.h"
+
+namespace wasp::graphics {
+
+	//bottom left skyline packer: the packed area is kept as a list of
+	//horizontal segments, and each rectangle goes where its top ends up lowest
+	class SkylinePacker {
+	private:
+		struct Segment {
+			int x{};
+			int y{};
+			int width{};
+		};
+
+		int width{};
+		int height{};
+		std::vector<Segment> skyline{};
+		int usedHeight{};
+
+	public:
+		SkylinePacker(int width, int height);
+
+		//false if it doesn't fit, in which case nothing changes
+		bool insert(int rectangleWidth, int rectangleHeight, int& x, int& y);
+
+		void reset();
+
+		int getUsedHeight() const {
+			return usedHeight;
+		}
+
+	private:
+		//lowest y a rectangle starting at segment index can sit at, or -1
+		int findY(std::size_t index, int rectangleWidth, int rectangleHeight) const;
+		void addSegment(std::size_t index, int x, int y, int rectangleWidth);
+	};
+
+	struct AtlasPlacement {
+		static constexpr int notPacked{ -1 };
+
+		int page{ notPacked };
+		geometry::Rectangle rectangle{};	//in the page, without the padding
+	};
+
+	//packs images into as few pages as it can, every image surrounded by
+	//padding pixels copied from its edge, so filtering at the border of a
+	//sub-rectangle samples the image itself rather than its neighbours
+	//images that don't fit in an empty page are left out
+	class TextureAtlasBuilder {
+	private:
+		int pageSize{};
+		int padding{};
+		std::vector<SoftwareBitmap> pages{};
+		uint64_t packedImagePixels{};
+
+	public:
+		TextureAtlasBuilder(int pageSize, int padding);
+
+		//placements come back in the order of the images
+		std::vector<AtlasPlacement> build(utility::Span<const SoftwareBitmap> images);
+
+		//the last page is cut down to the height it uses
+		const std::vector<SoftwareBitmap>& getPages() const {
+			return pages;
+		}
+
+		//image pixels over page pixels, padding counts as waste
+		double getEfficiency() const;
+
+	private:
+		void copyWithPadding(
+			const SoftwareBitmap& image,
+			SoftwareBitmap& page,
+			int x, 
+			int y
+		) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "framework.h"
+#include <stdexcept>
+
+namespace wasp::win32adaptor {
+	//raises the system timer resolution so sleeps wake close to when asked
+	class TimerResolutionGuard {
+	private:
+		UINT periodMilliseconds{};
+
+	public:
+		TimerResolutionGuard() = default;
+
+		void init(UINT periodMilliseconds) {
+			if (timeBeginPeriod(periodMilliseconds) != TIMERR_NOERROR) {
+				throw std::runtime_error{ "Error setting timer resolution" };
+			}
+			this->periodMilliseconds = periodMilliseconds;
+		}
+
+		~TimerResolutionGuard() {
+			cleanUp();
+		}
+
+		void cleanUp() {
+			if (periodMilliseconds) {
+				timeEndPeriod(periodMilliseconds);
+				periodMilliseconds = 0;
+			}
+		}
+	};
+}
\ No newline at end of file
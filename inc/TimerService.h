@@ -0,0 +1,141 @@
+#pragma once
+
+#include <functional>
+#include <chrono>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#include "TscClock.h"
+
+namespace wasp::time {
+
+	enum class TimerDelivery {
+		registeringThread,	//queued until that thread calls dispatch()
+		timerThread			//run inline on the timing thread, keep it short
+	};
+
+	using TimerId = uint64_t;
+
+	//one timing thread serving every one-shot and periodic timer
+	//a timer is delivered either to the thread that registered it, which picks
+	//it up in dispatch() and so is only as prompt as it calls that, or inline
+	//on the timing thread
+	//sleeps until shortly before the earliest deadline and spins the rest
+	class TimerService {
+	public:
+		using clockType = TscClock;
+		using timePointType = clockType::time_point;
+		using durationType = clockType::duration;
+		using callbackType = std::function<void()>;
+
+		static constexpr std::chrono::microseconds defaultSpinMargin{ 500 };
+
+	private:
+		//callbacks waiting for one registering thread to dispatch them
+		struct Mailbox {
+			std::mutex mutex{};
+			std::condition_variable condition{};
+			std::deque<std::shared_ptr<const callbackType>> callbacks{};
+			std::atomic<std::size_t> callbackCount{ 0 };
+		};
+
+		struct Timer {
+			std::shared_ptr<const callbackType> callback{};
+			durationType period{};	//zero for one-shots
+			timePointType deadline{};
+			std::shared_ptr<Mailbox> mailbox{};	//null for timerThread delivery
+		};
+
+		struct HeapEntry {
+			timePointType deadline{};
+			TimerId id{};
+
+			//std heap functions build a max heap, so earliest compares greatest
+			bool operator<(const HeapEntry& other) const {
+				return deadline > other.deadline;
+			}
+		};
+
+		std::chrono::microseconds spinMargin{};
+
+		std::mutex timerMutex{};
+		std::condition_variable timerCondition{};
+		std::vector<HeapEntry> deadlineHeap{};
+		//cancelled timers are dropped from here and their heap entries skipped
+		std::unordered_map<TimerId, Timer> timers{};
+		std::unordered_map<std::thread::id, std::shared_ptr<Mailbox>> mailboxes{};
+		TimerId nextId{ 1 };
+		std::atomic_bool running{ false };
+		//tells services apart for the per thread mailbox cache, even if one is
+		//later made at the same address as another
+		uint64_t serialNumber{};
+
+		std::thread thread{};
+
+	public:
+		explicit TimerService(std::chrono::microseconds spinMargin = defaultSpinMargin);
+
+		TimerService(const TimerService& other) = delete;
+		void operator=(const TimerService& other) = delete;
+
+		~TimerService();
+
+		void start();
+		//timers still pending are dropped, threads in sleepUntil are released
+		void stop();
+
+		TimerId addOneShot(
+			timePointType deadline,
+			const callbackType& callback,
+			TimerDelivery delivery = TimerDelivery::registeringThread
+		);
+
+		//fires every period from firstDeadline on, without drifting; a timer more
+		//than a period late skips ahead rather than firing in a burst
+		TimerId addPeriodic(
+			timePointType firstDeadline,
+			durationType period,
+			const callbackType& callback,
+			TimerDelivery delivery = TimerDelivery::registeringThread
+		);
+
+		//returns false if the timer had already fired or been cancelled; a
+		//callback already queued for dispatch still runs
+		bool cancel(TimerId id);
+
+		//runs the callbacks delivered to the calling thread, returns how many ran
+		std::size_t dispatch();
+
+		//blocks the calling thread until deadline, dispatching its timers meanwhile
+		//returns false if the service stopped first
+		bool sleepUntil(timePointType deadline);
+
+		timePointType now() const {
+			return clockType::now();
+		}
+
+	private:
+		TimerId addTimer(
+			timePointType firstDeadline,
+			durationType period,
+			const callbackType& callback,
+			TimerDelivery delivery
+		);
+
+		std::shared_ptr<Mailbox> getMailbox(std::thread::id threadId);
+
+		void timerLoop();
+		void fireDueTimers(std::unique_lock<std::mutex>& lock);
+		static void deliver(
+			const std::shared_ptr<const callbackType>& callback,
+			const std::shared_ptr<Mailbox>& mailbox
+		);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace wasp::utility {
+	//hands the latest value from one writer thread to one reader thread
+	//neither side ever waits, the reader just may see the same value again
+	template <typename T>
+	class TripleBuffer {
+	private:
+		static constexpr uint8_t indexMask{ 0b011 };
+		static constexpr uint8_t freshBit{ 0b100 };
+
+		std::array<T, 3> buffers{};
+		uint8_t writeIndex{ 0 };
+		std::atomic<uint8_t> middleIndex{ 1 };
+		uint8_t readIndex{ 2 };
+
+	public:
+		TripleBuffer() = default;
+
+		TripleBuffer(const TripleBuffer& other) = delete;
+		void operator=(const TripleBuffer& other) = delete;
+
+		//writer side
+		T& getWriteBuffer() {
+			return buffers[writeIndex];
+		}
+
+		void publish() {
+			writeIndex = middleIndex.exchange(
+				writeIndex | freshBit, 
+				std::memory_order_acq_rel
+			) & indexMask;
+		}
+
+		//reader side, returns true if a newer value was picked up
+		bool acquire() {
+			if (!(middleIndex.load(std::memory_order_relaxed) & freshBit)) {
+				return false;
+			}
+			readIndex = middleIndex.exchange(readIndex, std::memory_order_acq_rel)
+				& indexMask;
+			return true;
+		}
+
+		const T& getReadBuffer() const {
+			return buffers[readIndex];
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define WASP_TSC_READABLE
+#endif
+#endif
+
+#ifdef __GNUC__
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define WASP_TSC_READABLE
+#endif
+#endif
+
+namespace wasp::time {
+
+	//reads the cpu timestamp counter and converts it onto steady_clock's
+	//timeline, so its time points mix freely with steady_clock ones
+	//the counter is only used if it is invariant, meaning it ticks at a constant
+	//rate through power states and across cores; otherwise, or before
+	//calibrate(), now() is just steady_clock::now()
+	//call calibrate() once at startup, before any other thread reads the clock
+	class TscClock {
+	public:
+		using baseClockType = std::chrono::steady_clock;
+		using rep = baseClockType::rep;
+		using period = baseClockType::period;
+		using duration = baseClockType::duration;
+		using time_point = baseClockType::time_point;
+
+		static constexpr bool is_steady{ true };
+
+		static constexpr std::chrono::milliseconds defaultCalibrationTime{ 100 };
+
+	private:
+		struct Calibration {
+			bool usingTsc{};
+			uint64_t baseTicks{};
+			time_point baseTime{};
+			double nanosecondsPerTick{};
+		};
+
+		static Calibration calibration;
+
+	public:
+		//blocks for about calibrationTime, longer is more accurate
+		static void calibrate(std::chrono::milliseconds calibrationTime = defaultCalibrationTime);
+
+		static bool isUsingTsc() {
+			return calibration.usingTsc;
+		}
+
+		static double getTicksPerSecond() {
+			return calibration.usingTsc ? 1e9 / calibration.nanosecondsPerTick : 0.0;
+		}
+
+		//true if the cpu says its counter is invariant
+		static bool isTscInvariant();
+
+		static time_point now() {
+			#ifdef WASP_TSC_READABLE
+			if (calibration.usingTsc) {
+				const int64_t ticksSinceBase{
+					static_cast<int64_t>(__rdtsc() - calibration.baseTicks)
+				};
+				return calibration.baseTime + std::chrono::duration_cast<duration>(
+					std::chrono::duration<double, std::nano>{
+						static_cast<double>(ticksSinceBase) * calibration.nanosecondsPerTick
+					}
+				);
+			}
+			#endif
+			return baseClockType::now();
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "Point2.h"
+
+namespace wasp::graphics {
+
+	//drops draws whose bounds can't touch the viewport, and counts what it
+	//drops and lets through until the next beginFrame
+	class ViewportCuller {
+	private:
+		static constexpr float degreesToRadians{ 3.14159265358979f / 180.0f };
+
+		float viewportWidth{};
+		float viewportHeight{};
+		uint32_t drawnCount{};
+		uint32_t culledCount{};
+
+	public:
+		ViewportCuller(float viewportWidth, float viewportHeight)
+			: viewportWidth{ viewportWidth }
+			, viewportHeight{ viewportHeight } {
+		}
+
+		void beginFrame() {
+			drawnCount = 0;
+			culledCount = 0;
+		}
+
+		//width and height before scaling, rotation is about the center
+		bool isVisible(
+			const geometry::Point2 center,
+			float width,
+			float height,
+			float rotationDegrees,
+			float scale
+		) {
+			float halfWidth{ width * scale / 2 };
+			float halfHeight{ height * scale / 2 };
+			if (rotationDegrees != 0.0f) {
+				//any rotation fits in the circle through the corners, which
+				//settles everything not straddling an edge without any trig
+				const float radius{
+					std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight)
+				};
+				const bool straddlesEdge{
+					isBoxVisible(center, radius, radius) 
+						&& !isBoxInside(center, radius, radius)
+				};
+				if (straddlesEdge) {
+					//the axis aligned box around the rotated rectangle
+					const float radians{ rotationDegrees * degreesToRadians };
+					const float cosine{ std::abs(std::cos(radians)) };
+					const float sine{ std::abs(std::sin(radians)) };
+					const float rotatedHalfWidth{ cosine * halfWidth + sine * halfHeight };
+					halfHeight = sine * halfWidth + cosine * halfHeight;
+					halfWidth = rotatedHalfWidth;
+				}
+				else {
+					halfWidth = radius;
+					halfHeight = radius;
+				}
+			}
+			const bool visible{ isBoxVisible(center, halfWidth, halfHeight) };
+			if (visible) {
+				++drawnCount;
+			}
+			else {
+				++culledCount;
+			}
+			return visible;
+		}
+
+		uint32_t getDrawnCount() const {
+			return drawnCount;
+		}
+
+		uint32_t getCulledCount() const {
+			return culledCount;
+		}
+
+	private:
+		bool isBoxVisible(
+			const geometry::Point2 center, 
+			float halfWidth, 
+			float halfHeight
+		) const {
+			return center.x + halfWidth > 0.0f
+				&& center.x - halfWidth < viewportWidth
+				&& center.y + halfHeight > 0.0f
+				&& center.y - halfHeight < viewportHeight;
+		}
+
+		bool isBoxInside(
+			const geometry::Point2 center, 
+			float halfWidth, 
+			float halfHeight
+		) const {
+			return center.x - halfWidth >= 0.0f
+				&& center.x + halfWidth <= viewportWidth
+				&& center.y - halfHeight >= 0.0f
+				&& center.y + halfHeight <= viewportHeight;
+		}
+	};
+}
\ No newline at end of file
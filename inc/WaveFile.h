@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <istream>
+
+#include "Span.h"
+
+namespace wasp::sound::wave {
+
+	namespace constants {
+		//chunk identifiers as they appear read little-endian
+		constexpr uint32_t riffID{ 0x46464952 };	// "RIFF"
+		constexpr uint32_t waveID{ 0x45564157 };	// "WAVE"
+		constexpr uint32_t formatID{ 0x20746d66 };	// "fmt "
+		constexpr uint32_t dataID{ 0x61746164 };	// "data"
+
+		constexpr uint32_t minimumFormatSize{ 16 };
+
+		enum formatTags : uint16_t {
+			formatPCM = 0x0001,
+			formatIEEEFloat = 0x0003,
+			formatExtensible = 0xFFFE
+		};
+	}
+
+	struct WaveFormat {
+		uint16_t formatTag{};
+		uint16_t channels{};
+		uint32_t samplesPerSecond{};
+		uint32_t averageBytesPerSecond{};
+		uint16_t blockAlign{};
+		uint16_t bitsPerSample{};
+	};
+
+	static_assert(sizeof(WaveFormat) == constants::minimumFormatSize);
+
+	struct WaveFileView {
+		WaveFormat format{};
+		utility::Span<const std::byte> pcmData{};
+	};
+
+	struct WaveStreamHeader {
+		WaveFormat format{};
+		uint32_t dataSize{};
+	};
+
+	//walks the RIFF chunks of an in-memory wave file, pcmData points into fileBytes
+	WaveFileView parseWaveFile(utility::Span<const std::byte> fileBytes);
+
+	//reads up to the data chunk, leaving inStream at the first PCM byte
+	WaveStreamHeader readWaveStreamHeader(std::istream& inStream);
+
+	void throwIfFormatUnsupported(const WaveFormat& format);
+}
\ No newline at end of file
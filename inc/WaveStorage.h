@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include "framework.h"
+
+#include "ResourceStorage.h"
+#include "ResourceBase.h"
+#include "MappedFile.h"
+#include "WaveFile.h"
+
+#pragma warning(disable : 4250) //suppress inherit via dominance
+
+namespace wasp::game::gameresource {
+
+	//pcmData points into the mapped file, nothing is copied on load
+	struct WaveData {
+		file::MappedFile mappedFile{};
+		sound::wave::WaveFormat format{};
+		utility::Span<const std::byte> pcmData{};
+	};
+
+	class WaveStorage
+		: public resource::ResourceStorage<WaveData>
+		, public resource::FileLoadable
+		, public resource::ManifestLoadable
+	{
+		using ResourceType = resource::Resource<WaveData>;
+
+	public:
+		WaveStorage()
+			: FileLoadable{ {L"wav"} }
+			, ManifestLoadable{ {L"sound"} } {
+		}
+
+		void reload(const std::wstring& id) override;
+
+		resource::ResourceBase* loadFromFile(
+			const resource::FileOrigin& fileOrigin,
+			const resource::ResourceLoader& resourceLoader
+		) override;
+
+		resource::ResourceBase* loadFromManifest(
+			const resource::ManifestOrigin& manifestOrigin,
+			const resource::ResourceLoader& resourceLoader
+		) override;
+
+	private:
+		std::shared_ptr<ResourceType> makeResource(
+			const std::wstring& id,
+			const std::wstring& fileName,
+			const resource::ResourceOriginVariant& origin
+		);
+		static std::shared_ptr<WaveData> mapWaveFile(const std::wstring& fileName);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "WaveFile.h"
+#include "SpscRingBuffer.h"
+
+namespace wasp::sound {
+
+	struct StreamStatistics {
+		std::size_t bufferCapacity{};
+		std::size_t bufferFill{};
+		std::size_t minimumBufferFill{};
+		uint64_t bytesStreamed{};
+		uint64_t chunkReads{};
+		uint64_t underruns{};
+		uint64_t underrunBytes{};
+		int64_t slowestReadMicroseconds{};
+	};
+
+	//streams the PCM data of a wave file from disk through a fixed size ring buffer
+	//memory use depends only on bufferSeconds and chunkBytes, not the track length
+	class WaveStreamReader {
+	private:
+		static constexpr double defaultBufferSeconds{ 2.0 };
+		static constexpr std::size_t defaultChunkBytes{ 64 * 1024 };
+
+		//initialization order matters, each member is built from the ones above it
+		std::ifstream inStream;
+		wave::WaveStreamHeader header;
+		std::streampos dataStart;
+		uint32_t dataRemaining;
+		bool looping;
+
+		std::vector<std::byte> chunkBuffer;
+		utility::SpscRingBuffer<std::byte> ringBuffer;
+
+		std::thread fillThread{};
+		std::mutex fillMutex{};
+		std::condition_variable fillCondition{};
+		bool stopRequested{};
+		std::atomic_bool endOfStream{ false };
+
+		//written by the consumer
+		std::atomic<std::size_t> minimumBufferFill{};
+		std::atomic<uint64_t> underruns{ 0 };
+		std::atomic<uint64_t> underrunBytes{ 0 };
+		//written by the fill thread
+		std::atomic<uint64_t> bytesStreamed{ 0 };
+		std::atomic<uint64_t> chunkReads{ 0 };
+		std::atomic<int64_t> slowestReadMicroseconds{ 0 };
+
+	public:
+		WaveStreamReader(
+			const std::wstring& fileName,
+			bool looping = false,
+			double bufferSeconds = defaultBufferSeconds,
+			std::size_t chunkBytes = defaultChunkBytes
+		);
+
+		WaveStreamReader(const WaveStreamReader& other) = delete;
+		void operator=(const WaveStreamReader& other) = delete;
+
+		~WaveStreamReader();
+
+		const wave::WaveFormat& getFormat() const {
+			return header.format;
+		}
+
+		//fills the buffer before returning so playback can begin immediately
+		void start();
+		void stop();
+
+		//consumer side, never blocks; on underrun the rest of destination is silence
+		//returns the number of bytes of real audio written
+		std::size_t read(std::byte* destination, std::size_t byteCount);
+
+		//true once a non looping track has been fully consumed
+		bool isFinished() const;
+
+		StreamStatistics getStatistics() const;
+
+	private:
+		void fillLoop();
+		bool fillChunk();
+		std::byte getSilence() const;
+	};
+}
\ No newline at end of file
@@ -2,9 +2,13 @@
 
 #include "framework.h"
 #include <utility>
+#include <vector>
+#include <atomic>
+#include <cstdint>
 
 #include "IBitmapDrawer.h"
 #include "ITextDrawer.h"
+#include "ViewportCuller.h"
 
 namespace wasp::window {
     class WindowPainter 
@@ -12,6 +16,7 @@ namespace wasp::window {
         , public graphics::ITextDrawer
     {
     private:
+        HWND windowHandle{};
         CComPtr<ID2D1Factory> d2dFactoryPointer{};
         CComPtr<ID2D1HwndRenderTarget> renderTargetPointer{};
 
@@ -19,19 +24,48 @@ namespace wasp::window {
         CComPtr<IDWriteTextFormat> textFormatPointer{};
         CComPtr<ID2D1SolidColorBrush> textBrushPointer{};
 
+        //bitmaps outside the buffer never reach d2d
+        graphics::ViewportCuller viewportCuller;
+        //counts of the last finished frame, read from other threads
+        std::atomic<uint32_t> lastFrameDrawnCount{};
+        std::atomic<uint32_t> lastFrameCulledCount{};
+
+#ifdef WASP_D2D_SPRITE_BATCH
+        //null when the device doesn't support sprite batches
+        CComPtr<ID2D1DeviceContext3> deviceContextPointer{};
+        CComPtr<ID2D1SpriteBatch> spriteBatchPointer{};
+
+        //reused from batch to batch
+        std::vector<D2D1_RECT_F> spriteDestinations{};
+        std::vector<D2D1_RECT_U> spriteSources{};
+        std::vector<D2D1_COLOR_F> spriteColors{};
+        std::vector<D2D1_MATRIX_3X2_F> spriteTransforms{};
+#endif
+
     public:
         WindowPainter();
         ~WindowPainter() = default;
 
         void init(HWND windowHandle);
 
-        void paint(HWND windowHandle);
+        //the factory is single threaded, so after init everything below has
+        //to come from one thread at a time
+        void present(HWND windowHandle);
         void resize(HWND windowHandle);
 
         CComPtr<ID2D1HwndRenderTarget> getRenderTargetPointer() {
             return renderTargetPointer;
         }
 
+        //bitmaps and sprites drawn and culled in the last frame
+        uint32_t getLastFrameDrawnCount() const {
+            return lastFrameDrawnCount.load(std::memory_order_relaxed);
+        }
+
+        uint32_t getLastFrameCulledCount() const {
+            return lastFrameCulledCount.load(std::memory_order_relaxed);
+        }
+
         void beginDraw() override;
 
         void drawBitmap(
@@ -45,6 +79,11 @@ namespace wasp::window {
             const geometry::Rectangle& sourceRectangle
         ) override;
 
+        void drawBitmapBatch(
+            const CComPtr<ID2D1Bitmap>& bitmap,
+            utility::Span<const graphics::SpriteInstance> instances
+        ) override;
+
         void drawText(
             const geometry::Point2 pos,
             const std::wstring& text,
@@ -54,11 +93,18 @@ namespace wasp::window {
         void endDraw() override;
 
     private:
+        inline bool isVisible(
+            const geometry::Point2 center,
+            const D2D1_SIZE_F& size,
+            const graphics::BitmapDrawInstruction& bitmapDrawInstruction
+        );
+        inline bool isVisible(const graphics::SpriteInstance& instance);
+
         inline void makeBitmapDrawCall(
             ID2D1Bitmap& bitmap,
             const geometry::Point2 upperLeft,
-            float scaledWidth,
-            float scaledHeight,
+            float width,
+            float height,
             float opacity
         );
 
@@ -66,16 +112,16 @@ namespace wasp::window {
             ID2D1Bitmap& bitmap,
             const D2D1::Matrix3x2F& transform,
             const geometry::Point2 upperLeft,
-            float scaledWidth,
-            float scaledHeight,
+            float width,
+            float height,
             float opacity
         );
 
         inline void makeSubBitmapDrawCall(
             ID2D1Bitmap& bitmap,
             const geometry::Point2 upperLeft,
-            float scaledWidth,
-            float scaledHeight,
+            float width,
+            float height,
             float opacity,
             const geometry::Rectangle& sourceRectangle
         );
@@ -84,12 +130,22 @@ namespace wasp::window {
             ID2D1Bitmap& bitmap,
             const D2D1::Matrix3x2F& transform,
             const geometry::Point2 upperLeft,
-            float scaledWidth,
-            float scaledHeight,
+            float width,
+            float height,
             float opacity,
             const geometry::Rectangle& sourceRectangle
         );
 
+        void drawSpriteBatch(
+            ID2D1Bitmap& bitmap,
+            utility::Span<const graphics::SpriteInstance> instances
+        );
+
+        void drawSpriteLoop(
+            ID2D1Bitmap& bitmap,
+            utility::Span<const graphics::SpriteInstance> instances
+        );
+
         CComPtr<ID2D1Bitmap> getBufferBitmap();
 
         void getDeviceIndependentResources();
@@ -101,6 +157,7 @@ namespace wasp::window {
         void getRenderTargetPointer(HWND windowHandle);
         void makeBufferRenderTargetPointer();
         void makeTextBrushPointer();
+        void makeSpriteBatchPointer();
 
         void discardDeviceDependentResources();
     };
@@ -21,6 +21,11 @@ typedef struct IUnknown IUnknown;
 #pragma comment(lib, "Dwrite")
 #include <d2d1.h>
 #pragma comment(lib, "d2d1")
+//sprite batches need the windows 10 sdk
+#if __has_include(<d2d1_3.h>)
+#include <d2d1_3.h>
+#define WASP_D2D_SPRITE_BATCH
+#endif
 
 // C RunTime Header Files
 #include <stdlib.h>
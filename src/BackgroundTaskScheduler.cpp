@@ -0,0 +1,51 @@
+#include "BackgroundTaskScheduler.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+namespace wasp::game::gameloop {
+
+	void BackgroundTaskScheduler::post(taskType task, TaskPriority priority) {
+		if (!task) {
+			throw std::invalid_argument{ "Error posting empty background task" };
+		}
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		queues[static_cast<std::size_t>(priority)].push_back(std::move(task));
+		pendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool BackgroundTaskScheduler::popTask(taskType& task, TaskPriority& priority) {
+		if (!hasPendingTasks()) {
+			return false;
+		}
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		for (std::size_t i{ 0 }; i < priorityCount; ++i) {
+			if (!queues[i].empty()) {
+				task = std::move(queues[i].front());
+				queues[i].pop_front();
+				priority = static_cast<TaskPriority>(i);
+				pendingTaskCount.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void BackgroundTaskScheduler::pushTaskFront(taskType&& task, TaskPriority priority) {
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		queues[static_cast<std::size_t>(priority)].push_front(std::move(task));
+		pendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void BackgroundTaskScheduler::recordDrain(const SlackUsage& usage, secondsType overrun) {
+		++counters.drains;
+		counters.tasksRun += usage.tasksRun;
+		counters.totalSlackSeconds += usage.slackSeconds;
+		counters.totalUsedSeconds += usage.usedSeconds;
+		//only count overruns we caused, the loop may already be late on arrival
+		if (usage.tasksRun > 0) {
+			counters.maxOverrunSeconds = std::max(counters.maxOverrunSeconds, overrun.count());
+		}
+		counters.lastDrain = usage;
+	}
+}
\ No newline at end of file
@@ -96,6 +96,52 @@ namespace wasp::graphics {
 		return bitmapPointer;
 	}
 
+	SoftwareBitmap BitmapConstructor::copyWicPixels(
+		const CComPtr<IWICFormatConverter> formatConverterPointer
+	) {
+		UINT width{};
+		UINT height{};
+		if (FAILED(formatConverterPointer->GetSize(&width, &height))) {
+			throw HResultError{ "Error getting WIC bitmap size" };
+		}
+		SoftwareBitmap softwareBitmap{
+			static_cast<int>(width),
+			static_cast<int>(height),
+			std::vector<uint32_t>(static_cast<std::size_t>(width) * height)
+		};
+		HRESULT result{ formatConverterPointer->CopyPixels(
+			nullptr,
+			width * 4,
+			static_cast<UINT>(softwareBitmap.pixels.size() * 4),
+			reinterpret_cast<BYTE*>(softwareBitmap.pixels.data())
+		) };
+		if (FAILED(result)) {
+			throw HResultError{ "Error copying WIC bitmap pixels" };
+		}
+		return softwareBitmap;
+	}
+
+	CComPtr<ID2D1Bitmap> BitmapConstructor::makeD2DBitmap(
+		const SoftwareBitmap& softwareBitmap,
+		const CComPtr<ID2D1HwndRenderTarget> renderTargetPointer
+	) {
+		CComPtr<ID2D1Bitmap> bitmapPointer{};
+		HRESULT result{ renderTargetPointer->CreateBitmap(
+			D2D1::SizeU(softwareBitmap.width, softwareBitmap.height),
+			softwareBitmap.pixels.data(),
+			softwareBitmap.width * 4,	//pitch
+			D2D1::BitmapProperties(D2D1::PixelFormat(
+				DXGI_FORMAT_B8G8R8A8_UNORM,
+				D2D1_ALPHA_MODE_PREMULTIPLIED
+			)),
+			&bitmapPointer
+		) };
+		if (FAILED(result)) {
+			throw HResultError{ "Error creating bitmap from pixels" };
+		}
+		return bitmapPointer;
+	}
+
 	void BitmapConstructor::initWicFormatConverter(
 		const CComPtr<IWICFormatConverter> formatConverterPointer,
 		const CComPtr<IWICBitmapFrameDecode> framePointer
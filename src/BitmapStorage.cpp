@@ -1,27 +1,27 @@
 #include "BitmapStorage.h"
 
 #include "FileUtil.h"
+#include "TextureAtlas.h"
 
 namespace wasp::game::gameresource {
 
+	//builds the replacement before swapping it in; it keeps the old d2d bitmap
+	//so the render thread can draw that until it has made the new one
 	void BitmapStorage::reload(const std::wstring& id) {
 		if (resourceLoaderPointer) {
-			auto found{ resourceMap.find(id) };
-			if (found != resourceMap.end()) {
-				ResourceType& resource{
-					*(std::get<1>(*found))
-				};
+			std::shared_ptr<ResourceType> resourcePointer{ findResource(id) };
+			if (resourcePointer) {
 				const resource::ResourceOriginVariant origin{
-					resource.getOrigin()
+					resourcePointer->getOrigin()
 				};
+				std::wstring const* fileName{};
 				switch (origin.index()) {
 					case 0: {
 						resource::FileOrigin const* fileTest{
 							std::get_if<resource::FileOrigin>(&origin) 
 						};
 						if (fileTest) {
-							resourceMap.erase(found);
-							loadFromFile(*fileTest, *resourceLoaderPointer);
+							fileName = &fileTest->fileName;
 						}
 						break;
 					}
@@ -30,12 +30,26 @@ namespace wasp::game::gameresource {
 							std::get_if<resource::ManifestOrigin>(&origin)
 						};
 						if (manifestTest) {
-							resourceMap.erase(found);
-							loadFromManifest(*manifestTest, *resourceLoaderPointer);
+							fileName = &manifestTest->manifestArguments[1];
 						}
 						break;
 					}
 				}
+				if (fileName) {
+					std::shared_ptr<ResourceType> newResourcePointer{
+						makeResource(id, *fileName, origin)
+					};
+					const std::shared_ptr<WicAndD2DBitmaps> oldData{
+						resourcePointer->getDataPointerCopy()
+					};
+					if (oldData) {
+						//not published yet, so it can still be changed in place
+						newResourcePointer->getDataPointerCopy()->d2dBitmap = 
+							oldData->d2dBitmap;
+					}
+					replaceResource(id, newResourcePointer);
+					queueD2DBitmap(newResourcePointer);
+				}
 			}
 		}
 		else {
@@ -47,35 +61,16 @@ namespace wasp::game::gameresource {
 		const resource::FileOrigin& fileOrigin,
 		const resource::ResourceLoader& resourceLoader
 	) {
-		CComPtr<IWICFormatConverter> wicBitmap{
-			bitmapConstructorPointer->getWicFormatConverterPointer(fileOrigin.fileName)
-		};
-
-		CComPtr<ID2D1Bitmap> d2dBitmap{};
-		if (renderTargetPointer) {
-			d2dBitmap = bitmapConstructorPointer->converWicBitmapToD2D(
-				wicBitmap, renderTargetPointer
-			);
-		}
-
 		const std::wstring& id{ file::getFileName(fileOrigin.fileName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
-		std::shared_ptr<resource::Resource<WicAndD2DBitmaps>> resourceSharedPointer{
-			std::make_shared<resource::Resource<WicAndD2DBitmaps>>(
-				id,
-				fileOrigin,
-				std::make_shared<WicAndD2DBitmaps>(
-					WicAndD2DBitmaps{wicBitmap, {d2dBitmap}}
-				)
-			)
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			makeResource(id, fileOrigin.fileName, fileOrigin)
 		};
-
-		resourceSharedPointer->setStoragePointer(this);
-
-		resourceMap.insert({ id, resourceSharedPointer });
+		insertResource(id, resourceSharedPointer);
+		queueD2DBitmap(resourceSharedPointer);
 		return resourceSharedPointer.get(); //C26816 pointer to memory on stack?
 	}
 
@@ -84,36 +79,42 @@ namespace wasp::game::gameresource {
 		const resource::ResourceLoader& resourceLoader
 	) {
 		const std::wstring& fileName{ manifestOrigin.manifestArguments[1] };
-		CComPtr<IWICFormatConverter> wicBitmap{
-			bitmapConstructorPointer->getWicFormatConverterPointer(fileName)
-		};
-
-		CComPtr<ID2D1Bitmap> d2dBitmap{};
-		if (renderTargetPointer) {
-			d2dBitmap = bitmapConstructorPointer->converWicBitmapToD2D(
-				wicBitmap, renderTargetPointer
-			);
-		}
-
 		const std::wstring& id{ file::getFileName(fileName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
-		std::shared_ptr<resource::Resource<WicAndD2DBitmaps>> resourceSharedPointer{
-			std::make_shared<resource::Resource<WicAndD2DBitmaps>>(
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			makeResource(id, fileName, manifestOrigin)
+		};
+		insertResource(id, resourceSharedPointer);
+		queueD2DBitmap(resourceSharedPointer);
+		return resourceSharedPointer.get(); //C26816 pointer to memory on stack?
+	}
+
+	//decodes only, this runs on loader threads; the d2d bitmap is made by
+	//setRenderTargetPointerAndLoadD2DBitmaps or createQueuedD2DBitmaps
+	std::shared_ptr<BitmapStorage::ResourceType> BitmapStorage::makeResource(
+		const std::wstring& id,
+		const std::wstring& fileName,
+		const resource::ResourceOriginVariant& origin
+	) {
+		CComPtr<IWICFormatConverter> wicBitmap{
+			bitmapConstructorPointer->getWicFormatConverterPointer(fileName)
+		};
+
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			std::make_shared<ResourceType>(
 				id,
-				manifestOrigin,
+				origin,
 				std::make_shared<WicAndD2DBitmaps>(
-					WicAndD2DBitmaps{wicBitmap, {d2dBitmap}}
+					WicAndD2DBitmaps{wicBitmap}
 				)
 			)
 		};
 
 		resourceSharedPointer->setStoragePointer(this);
-
-		resourceMap.insert({ id, resourceSharedPointer });
-		return resourceSharedPointer.get(); //C26816 pointer to memory on stack?
+		return resourceSharedPointer;
 	}
 	
 	void BitmapStorage::setRenderTargetPointerAndLoadD2DBitmaps(
@@ -121,6 +122,11 @@ namespace wasp::game::gameresource {
 	){
 		this->renderTargetPointer = renderTargetPointer;
 		throwIfCannotConstructD2DBitmaps();
+		{
+			//set before the walk, so an image is either walked or queued
+			std::lock_guard<std::mutex> lock{ d2dQueueMutex };
+			queueD2DBitmaps = true;
+		}
 		forEach(
 			[&](std::shared_ptr<ResourceType> resourceSharedPointer) {
 				loadD2DBitmap(*resourceSharedPointer);
@@ -128,11 +134,109 @@ namespace wasp::game::gameresource {
 		);
 	}
 
+	void BitmapStorage::createQueuedD2DBitmaps() {
+		std::vector<std::shared_ptr<ResourceType>> queued{};
+		{
+			std::lock_guard<std::mutex> lock{ d2dQueueMutex };
+			queued.swap(d2dQueue);
+		}
+		for (const std::shared_ptr<ResourceType>& resourcePointer : queued) {
+			//replaced again since, its replacement is queued as well; not found
+			//can mean its load hasn't been published yet, so it is still made
+			const std::shared_ptr<ResourceType> current{
+				findResource(resourcePointer->getID())
+			};
+			if (current && current != resourcePointer) {
+				continue;
+			}
+			loadD2DBitmap(*resourcePointer);
+		}
+	}
+
+	void BitmapStorage::buildAtlases(int pageSize, int padding) {
+		throwIfCannotConstructD2DBitmaps();
+
+		std::vector<std::shared_ptr<ResourceType>> resources{};
+		std::vector<graphics::SoftwareBitmap> images{};
+		forEach(
+			[&](std::shared_ptr<ResourceType> resourceSharedPointer) {
+				const std::shared_ptr<WicAndD2DBitmaps> data{
+					resourceSharedPointer->getDataPointerCopy()
+				};
+				if (data && data->wicBitmap) {
+					resources.push_back(resourceSharedPointer);
+					images.push_back(BitmapConstructor::copyWicPixels(data->wicBitmap));
+				}
+			}
+		);
+
+		graphics::TextureAtlasBuilder atlasBuilder{ pageSize, padding };
+		const std::vector<graphics::AtlasPlacement> placements{
+			atlasBuilder.build(images)
+		};
+
+		atlasPointers.clear();
+		for (const graphics::SoftwareBitmap& page : atlasBuilder.getPages()) {
+			atlasPointers.push_back(
+				bitmapConstructorPointer->makeD2DBitmap(page, renderTargetPointer)
+			);
+		}
+		atlasPages = atlasBuilder.getPages();
+		atlasEfficiency = atlasBuilder.getEfficiency();
+
+		//new data rather than changing it in place, anything holding the old
+		//data keeps a consistent copy
+		for (std::size_t i{ 0 }; i < resources.size(); ++i) {
+			const graphics::AtlasPlacement& placement{ placements[i] };
+			if (placement.page == graphics::AtlasPlacement::notPacked) {
+				continue;
+			}
+			WicAndD2DBitmaps data{ *resources[i]->getDataPointerCopy() };
+			data.atlasBitmap = atlasPointers[placement.page];
+			data.atlasRectangle = placement.rectangle;
+			resources[i]->setData(std::make_shared<WicAndD2DBitmaps>(data));
+		}
+	}
+
+	AtlasRegion BitmapStorage::getAtlasRegion(const std::wstring& id) {
+		const std::shared_ptr<WicAndD2DBitmaps> data{ get(id) };
+		if (!data) {
+			return {};
+		}
+		if (data->atlasBitmap) {
+			return { data->atlasBitmap, data->atlasRectangle };
+		}
+		AtlasRegion region{ data->d2dBitmap };
+		if (data->d2dBitmap) {
+			const D2D1_SIZE_F size{ data->d2dBitmap->GetSize() };
+			region.rectangle = { 0.0f, 0.0f, size.width, size.height };
+		}
+		return region;
+	}
+
+	void BitmapStorage::queueD2DBitmap(
+		const std::shared_ptr<ResourceType>& resourcePointer
+	) {
+		std::lock_guard<std::mutex> lock{ d2dQueueMutex };
+		if (queueD2DBitmaps) {
+			d2dQueue.push_back(resourcePointer);
+		}
+	}
+
+	//new data rather than changing it in place, readers may be drawing the old
+	//data; left alone if the image was unloaded meanwhile
 	void BitmapStorage::loadD2DBitmap(ResourceType& resource) {
-		auto& data{ *resource.getDataPointerCopy() }; //C26815 dangling pointer?
-		data.d2dBitmap = bitmapConstructorPointer->converWicBitmapToD2D(
-			data.wicBitmap, renderTargetPointer
+		std::shared_ptr<WicAndD2DBitmaps> data{ resource.getDataPointerCopy() };
+		if (!data) {
+			return;
+		}
+		std::shared_ptr<WicAndD2DBitmaps> newData{
+			std::make_shared<WicAndD2DBitmaps>(*data)
+		};
+		newData->d2dBitmap = bitmapConstructorPointer->converWicBitmapToD2D(
+			data->wicBitmap, renderTargetPointer
 		);
+		resource.compareAndSetData(data, newData);
 	}
 
 	void BitmapStorage::throwIfCannotConstructD2DBitmaps() {
@@ -6,10 +6,12 @@ namespace wasp::game::gameresource {
 
 	void DirectoryStorage::reload(const std::wstring& id){
 		if (resourceLoaderPointer) {
-			auto found{ resourceMap.find(id) };
-			if (found != resourceMap.end()) {
+			std::shared_ptr<resource::Resource<resource::ChildList>> resourcePointer{
+				findResource(id)
+			};
+			if (resourcePointer) {
 				const resource::ResourceOriginVariant origin{
-					std::get<1>(*found)->getOrigin()
+					resourcePointer->getOrigin()
 				};
 				switch (origin.index()) {
 					case 0: {
@@ -53,7 +55,7 @@ namespace wasp::game::gameresource {
 		);
 
 		const std::wstring& id{ file::getFileName(fileOrigin.fileName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
@@ -71,7 +73,7 @@ namespace wasp::game::gameresource {
 
 		resourceSharedPointer->setStoragePointer(this);
 
-		resourceMap.insert({ id, resourceSharedPointer });
+		insertResource(id, resourceSharedPointer);
 		return resourceSharedPointer.get();
 	}
 
@@ -91,7 +93,7 @@ namespace wasp::game::gameresource {
 		);
 
 		const std::wstring& id{ file::getFileName(directoryName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
@@ -109,7 +111,7 @@ namespace wasp::game::gameresource {
 
 		resourceSharedPointer->setStoragePointer(this);
 
-		resourceMap.insert({ id, resourceSharedPointer });
+		insertResource(id, resourceSharedPointer);
 		return resourceSharedPointer.get();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "DrawList.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace wasp::graphics {
+
+	namespace {
+		constexpr int radixBits{ 8 };
+		constexpr std::size_t radixSize{ 1 << radixBits };
+		constexpr int keyBits{ 32 };
+	}
+
+	void DrawList::beginDraw() {
+		commandCount = 0;
+		instanceCount = 0;
+		characterCount = 0;
+		layer = 0;
+		blendMode = BlendMode::alpha;
+
+		//let go of last frame's bitmaps but keep the slots
+		for (std::size_t i{ 0 }; i < textureCount; ++i) {
+			textures[i] = nullptr;
+		}
+		textureCount = 0;
+		lastTextureIndex = 0;
+	}
+
+	void DrawList::drawBitmap(
+		const geometry::Point2 center,
+		const BitmapDrawInstruction& bitmapDrawInstruction
+	) {
+		DrawCommand& command{ nextCommand(
+			CommandType::bitmap,
+			getTextureIndex(bitmapDrawInstruction.getBitmap())
+		) };
+		command.position = center;
+		command.rotationDegrees = bitmapDrawInstruction.getRotationDegrees();
+		command.opacity = bitmapDrawInstruction.getOpacity();
+		command.scale = bitmapDrawInstruction.getScale();
+	}
+
+	void DrawList::drawSubBitmap(
+		const geometry::Point2 center,
+		const BitmapDrawInstruction& bitmapDrawInstruction,
+		const geometry::Rectangle& sourceRectangle
+	) {
+		DrawCommand& command{ nextCommand(
+			CommandType::subBitmap,
+			getTextureIndex(bitmapDrawInstruction.getBitmap())
+		) };
+		command.position = center;
+		command.sourceRectangle = sourceRectangle;
+		command.rotationDegrees = bitmapDrawInstruction.getRotationDegrees();
+		command.opacity = bitmapDrawInstruction.getOpacity();
+		command.scale = bitmapDrawInstruction.getScale();
+	}
+
+	void DrawList::drawBitmapBatch(
+		const CComPtr<ID2D1Bitmap>& bitmap,
+		utility::Span<const SpriteInstance> instances
+	) {
+		DrawCommand& command{ nextCommand(
+			CommandType::bitmapBatch, 
+			getTextureIndex(bitmap)
+		) };
+		command.firstElement = static_cast<uint32_t>(instanceCount);
+		command.elementCount = static_cast<uint32_t>(instances.size());
+
+		//only grows, so a steady scene stops allocating after the first frames
+		if (this->instances.size() < instanceCount + instances.size()) {
+			this->instances.resize(instanceCount + instances.size());
+		}
+		std::copy(
+			instances.begin(),
+			instances.end(),
+			this->instances.begin() + instanceCount
+		);
+		instanceCount += instances.size();
+	}
+
+	void DrawList::drawText(
+		const geometry::Point2 pos,
+		const std::wstring& text,
+		const std::pair<float, float> bounds
+	) {
+		DrawCommand& command{ nextCommand(CommandType::text, textTextureIndex) };
+		command.position = pos;
+		command.boundsWidth = std::get<0>(bounds);
+		command.boundsHeight = std::get<1>(bounds);
+		command.firstElement = static_cast<uint32_t>(characterCount);
+		command.elementCount = static_cast<uint32_t>(text.size());
+
+		if (characters.size() < characterCount + text.size()) {
+			characters.resize(characterCount + text.size());
+		}
+		std::copy(text.begin(), text.end(), characters.begin() + characterCount);
+		characterCount += text.size();
+	}
+
+	void DrawList::endDraw() {
+		sortCommands();
+	}
+
+	void DrawList::replay(IBitmapDrawer& bitmapDrawer, ITextDrawer& textDrawer) const {
+		BitmapDrawInstruction bitmapDrawInstruction{};
+		for (std::size_t i{ 0 }; i < commandCount; ++i) {
+			const DrawCommand& command{ commands[sortEntries[i].commandIndex] };
+			switch (command.type) {
+				case CommandType::bitmap:
+				case CommandType::subBitmap:
+					bitmapDrawInstruction.setBitmap(getTexture(command));
+					bitmapDrawInstruction.setRotationDegrees(command.rotationDegrees);
+					bitmapDrawInstruction.setOpacity(command.opacity);
+					bitmapDrawInstruction.setScale(command.scale);
+					if (command.type == CommandType::bitmap) {
+						bitmapDrawer.drawBitmap(command.position, bitmapDrawInstruction);
+					}
+					else {
+						bitmapDrawer.drawSubBitmap(
+							command.position,
+							bitmapDrawInstruction,
+							command.sourceRectangle
+						);
+					}
+					break;
+				case CommandType::bitmapBatch:
+					bitmapDrawer.drawBitmapBatch(
+						getTexture(command),
+						{ instances.data() + command.firstElement, command.elementCount }
+					);
+					break;
+				case CommandType::text:
+					replayText.assign(
+						characters.data() + command.firstElement, 
+						command.elementCount
+					);
+					textDrawer.drawText(
+						command.position,
+						replayText,
+						{ command.boundsWidth, command.boundsHeight }
+					);
+					break;
+			}
+		}
+	}
+
+	std::size_t DrawList::countTextureSwitches() const {
+		std::size_t switches{};
+		uint32_t currentTexture{ textTextureIndex };
+		for (std::size_t i{ 0 }; i < commandCount; ++i) {
+			const DrawCommand& command{ commands[sortEntries[i].commandIndex] };
+			const uint32_t texture{ command.sortKey & textTextureIndex };
+			if (texture != textTextureIndex && texture != currentTexture) {
+				++switches;
+				currentTexture = texture;
+			}
+		}
+		return switches;
+	}
+
+	DrawList::DrawCommand& DrawList::nextCommand(
+		CommandType type, 
+		uint16_t textureIndex
+	) {
+		if (commandCount == commands.size()) {
+			commands.emplace_back();
+		}
+		DrawCommand& command{ commands[commandCount++] };
+		command = DrawCommand{};
+		command.type = type;
+		command.sortKey = (static_cast<uint32_t>(layer) << 24)
+			| (static_cast<uint32_t>(blendMode) << 16)
+			| textureIndex;
+		return command;
+	}
+
+	const CComPtr<ID2D1Bitmap>& DrawList::getTexture(const DrawCommand& command) const {
+		return textures[command.sortKey & textTextureIndex];
+	}
+
+	uint16_t DrawList::getTextureIndex(ID2D1Bitmap* bitmap) {
+		//draws tend to repeat the same bitmap, and a frame only uses a few, so
+		//a linear search behind a one entry cache is enough
+		if (lastTextureIndex < textureCount 
+			&& static_cast<ID2D1Bitmap*>(textures[lastTextureIndex]) == bitmap
+		) {
+			return static_cast<uint16_t>(lastTextureIndex);
+		}
+		for (std::size_t i{ 0 }; i < textureCount; ++i) {
+			if (static_cast<ID2D1Bitmap*>(textures[i]) == bitmap) {
+				lastTextureIndex = i;
+				return static_cast<uint16_t>(i);
+			}
+		}
+		if (textureCount == maxTextures) {
+			throw std::runtime_error{ "Error too many textures in one draw list" };
+		}
+		if (textureCount == textures.size()) {
+			textures.emplace_back();
+		}
+		textures[textureCount] = bitmap;
+		lastTextureIndex = textureCount++;
+		return static_cast<uint16_t>(lastTextureIndex);
+	}
+
+	//lsd radix sort, stable so commands with equal keys keep their order
+	void DrawList::sortCommands() {
+		sortEntries.resize(commandCount);
+		sortScratch.resize(commandCount);
+		for (std::size_t i{ 0 }; i < commandCount; ++i) {
+			sortEntries[i] = { commands[i].sortKey, static_cast<uint32_t>(i) };
+		}
+		if (commandCount < 2) {
+			return;
+		}
+
+		SortEntry* source{ sortEntries.data() };
+		SortEntry* destination{ sortScratch.data() };
+		for (int shift{ 0 }; shift < keyBits; shift += radixBits) {
+			std::array<std::size_t, radixSize> offsets{};
+			for (std::size_t i{ 0 }; i < commandCount; ++i) {
+				++offsets[(source[i].key >> shift) & (radixSize - 1)];
+			}
+			//usually the layer and blend bytes are all the same
+			if (offsets[(source[0].key >> shift) & (radixSize - 1)] == commandCount) {
+				continue;
+			}
+			std::size_t total{};
+			for (std::size_t& offset : offsets) {
+				const std::size_t count{ offset };
+				offset = total;
+				total += count;
+			}
+			for (std::size_t i{ 0 }; i < commandCount; ++i) {
+				const SortEntry& entry{ source[i] };
+				destination[offsets[(entry.key >> shift) & (radixSize - 1)]++] = entry;
+			}
+			std::swap(source, destination);
+		}
+		if (source != sortEntries.data()) {
+			std::copy(source, source + commandCount, sortEntries.data());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "FrameSkipController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace wasp::game::gameloop {
+
+	FrameSkipController::FrameSkipController(
+		int maxUpdatesWithoutFrame, 
+		secondsType updatePeriod
+	)
+		: maxUpdatesWithoutFrame{ maxUpdatesWithoutFrame }
+		, updatePeriodSeconds{ updatePeriod.count() } {
+		if (maxUpdatesWithoutFrame < 1) {
+			throw std::invalid_argument{ "Error maxUpdatesWithoutFrame < 1" };
+		}
+		counters.catchUpLimit = maxUpdatesWithoutFrame;
+	}
+
+	void FrameSkipController::recordUpdate(secondsType cost, bool catchingUp) {
+		++counters.updates;
+		if (catchingUp) {
+			++counters.catchUpUpdates;
+		}
+		counters.averageUpdateSeconds = (counters.averageUpdateSeconds * smoothing)
+			+ (cost.count() * (1.0 - smoothing));
+		updateCatchUpLimit();
+	}
+
+	void FrameSkipController::recordFrame(secondsType cost, bool forced) {
+		++counters.frames;
+		if (forced) {
+			++counters.forcedFrames;
+		}
+		counters.averageDrawSeconds = (counters.averageDrawSeconds * smoothing)
+			+ (cost.count() * (1.0 - smoothing));
+		updateCatchUpLimit();
+	}
+
+	void FrameSkipController::recordDroppedUpdates(uint64_t droppedUpdates) {
+		counters.droppedUpdates += droppedUpdates;
+	}
+
+	//cheap updates can all be caught up on, expensive ones would starve drawing
+	//so fewer are allowed per frame and the rest of the backlog gets dropped
+	void FrameSkipController::updateCatchUpLimit() {
+		const double frameBudget{
+			maxUpdatesWithoutFrame * updatePeriodSeconds - counters.averageDrawSeconds
+		};
+		int limit{ maxUpdatesWithoutFrame };
+		if (counters.averageUpdateSeconds > 0.0) {
+			const double affordable{
+				std::floor(frameBudget / counters.averageUpdateSeconds)
+			};
+			if (affordable < limit) {
+				limit = static_cast<int>(affordable);
+			}
+		}
+		counters.catchUpLimit = std::max(limit, 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "HitchDetector.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Log.h"
+
+namespace wasp::debug {
+
+	namespace {
+		constexpr const char* phaseNames[framePhaseCount]{
+			"update",
+			"draw",
+			"present",
+			"messagePump"
+		};
+
+		double toMilliseconds(int64_t nanoseconds) {
+			return static_cast<double>(nanoseconds) / 1'000'000.0;
+		}
+	}
+
+	HitchDetector::HitchDetector(
+		std::size_t historySize,
+		std::chrono::duration<double> hitchThreshold,
+		std::size_t framesAfterHitch,
+		const std::string& dumpFilePrefix
+	)
+		: epoch{ clockType::now() }
+		, hitchThreshold{ 
+			std::chrono::duration_cast<std::chrono::nanoseconds>(hitchThreshold) 
+		}
+		, framesAfterHitch{ framesAfterHitch }
+		, dumpFilePrefix{ dumpFilePrefix }
+		, history(historySize) {
+		if (historySize <= framesAfterHitch) {
+			throw std::invalid_argument{ "Error hitch history too short" };
+		}
+		dumpThread = std::thread{ [&] { dumpLoop(); } };
+	}
+
+	HitchDetector::~HitchDetector() {
+		{
+			std::lock_guard<std::mutex> lock{ dumpMutex };
+			stopRequested = true;
+		}
+		dumpCondition.notify_one();
+		if (dumpThread.joinable()) {
+			dumpThread.join();
+		}
+	}
+
+	void HitchDetector::recordPhase(
+		FramePhase phase, 
+		timePointType begin, 
+		timePointType end
+	) {
+		addToPhase(phase, toNanoseconds(begin), toNanoseconds(end));
+	}
+
+	void HitchDetector::recordPresent(timePointType begin, timePointType end) {
+		//odd while writing
+		const uint32_t sequence{ presentSequence.load(std::memory_order_relaxed) };
+		presentSequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		presentBeginNanoseconds.store(toNanoseconds(begin), std::memory_order_relaxed);
+		presentEndNanoseconds.store(toNanoseconds(end), std::memory_order_relaxed);
+		presentSequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void HitchDetector::endFrame(timePointType frameEnd) {
+		foldPresent();
+
+		const int64_t frameEndNanoseconds{ toNanoseconds(frameEnd) };
+		currentFrame.endNanoseconds = frameEndNanoseconds;
+		history[currentFrame.frameIndex % history.size()] = currentFrame;
+
+		//the first frame has no real start, so it can't be a hitch
+		if (hasPreviousFrame
+			&& frameEndNanoseconds - currentFrame.beginNanoseconds > hitchThreshold.count()
+		) {
+			++hitchCount;
+			//a hitch inside the window of a pending one goes in the same dump
+			if (!dumpPending) {
+				dumpPending = true;
+				pendingHitchFrameIndex = currentFrame.frameIndex;
+			}
+		}
+		if (dumpPending 
+			&& currentFrame.frameIndex >= pendingHitchFrameIndex + framesAfterHitch
+		) {
+			queueDump(pendingHitchFrameIndex);
+			dumpPending = false;
+		}
+
+		hasPreviousFrame = true;
+		const uint64_t nextFrameIndex{ currentFrame.frameIndex + 1 };
+		currentFrame = FrameRecord{};
+		currentFrame.frameIndex = nextFrameIndex;
+		currentFrame.beginNanoseconds = frameEndNanoseconds;
+	}
+
+	void HitchDetector::restartFrame(timePointType frameBegin) {
+		const uint64_t frameIndex{ currentFrame.frameIndex };
+		currentFrame = FrameRecord{};
+		currentFrame.frameIndex = frameIndex;
+		currentFrame.beginNanoseconds = toNanoseconds(frameBegin);
+		hasPreviousFrame = false;
+	}
+
+	int64_t HitchDetector::toNanoseconds(timePointType timePoint) const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			timePoint - epoch
+		).count();
+	}
+
+	void HitchDetector::foldPresent() {
+		const uint32_t sequence{ presentSequence.load(std::memory_order_acquire) };
+		if (sequence == lastFoldedPresentSequence || (sequence & 1)) {
+			return;
+		}
+		const int64_t begin{ presentBeginNanoseconds.load(std::memory_order_relaxed) };
+		const int64_t end{ presentEndNanoseconds.load(std::memory_order_relaxed) };
+		std::atomic_thread_fence(std::memory_order_acquire);
+		//torn by a present that finished meanwhile, pick it up next frame
+		if (presentSequence.load(std::memory_order_relaxed) != sequence) {
+			return;
+		}
+		lastFoldedPresentSequence = sequence;
+		addToPhase(FramePhase::present, begin, end);
+	}
+
+	void HitchDetector::addToPhase(
+		FramePhase phase, 
+		int64_t beginNanoseconds, 
+		int64_t endNanoseconds
+	) {
+		PhaseRecord& phaseRecord{ currentFrame.phases[static_cast<std::size_t>(phase)] };
+		if (phaseRecord.count == 0) {
+			phaseRecord.firstBeginNanoseconds = beginNanoseconds;
+		}
+		phaseRecord.totalNanoseconds += endNanoseconds - beginNanoseconds;
+		++phaseRecord.count;
+	}
+
+	const FrameRecord& HitchDetector::getFrame(uint64_t frameIndex) const {
+		return history[frameIndex % history.size()];
+	}
+
+	//copies the frames in order, the loop thread carries on recording over
+	//the history straight away
+	void HitchDetector::queueDump(uint64_t hitchFrameIndex) {
+		const uint64_t lastFrameIndex{ currentFrame.frameIndex };
+		const uint64_t framesKept{ std::min<uint64_t>(lastFrameIndex + 1, history.size()) };
+		const uint64_t firstFrameIndex{ lastFrameIndex + 1 - framesKept };
+
+		PendingDump dump{ hitchFrameIndex };
+		dump.frames.reserve(static_cast<std::size_t>(framesKept));
+		for (uint64_t i{ firstFrameIndex }; i <= lastFrameIndex; ++i) {
+			dump.frames.push_back(getFrame(i));
+		}
+		{
+			std::lock_guard<std::mutex> lock{ dumpMutex };
+			pendingDumps.push_back(std::move(dump));
+		}
+		dumpCondition.notify_one();
+	}
+
+	void HitchDetector::dumpLoop() {
+		std::unique_lock<std::mutex> lock{ dumpMutex };
+		while (true) {
+			dumpCondition.wait(lock, [&] { return stopRequested || !pendingDumps.empty(); });
+			//queued dumps are still written when stopping
+			if (pendingDumps.empty()) {
+				return;
+			}
+			PendingDump dump{ std::move(pendingDumps.front()) };
+			pendingDumps.pop_front();
+			lock.unlock();
+			writeDump(dump);
+			lock.lock();
+		}
+	}
+
+	//runs on the dump thread, a diagnostics file that can't be written is not
+	//worth stopping the game for
+	void HitchDetector::writeDump(const PendingDump& dump) const {
+		std::ofstream outStream{ 
+			dumpFilePrefix + std::to_string(dump.hitchFrameIndex) + ".csv" 
+		};
+		if (!outStream) {
+			log::warning("could not open hitch dump file for frame {}", dump.hitchFrameIndex);
+			return;
+		}
+		outStream << "frame,hitch,beginMs,frameMs";
+		for (const char* phaseName : phaseNames) {
+			outStream << ',' << phaseName << "BeginMs," 
+				<< phaseName << "Ms," 
+				<< phaseName << "Count";
+		}
+		outStream << '\n';
+		for (const FrameRecord& frame : dump.frames) {
+			const int64_t frameNanoseconds{ frame.endNanoseconds - frame.beginNanoseconds };
+			outStream << frame.frameIndex << ','
+				<< (frameNanoseconds > hitchThreshold.count() ? 1 : 0) << ','
+				<< toMilliseconds(frame.beginNanoseconds) << ','
+				<< toMilliseconds(frameNanoseconds);
+			for (const PhaseRecord& phaseRecord : frame.phases) {
+				outStream << ',' << toMilliseconds(phaseRecord.firstBeginNanoseconds)
+					<< ',' << toMilliseconds(phaseRecord.totalNanoseconds)
+					<< ',' << phaseRecord.count;
+			}
+			outStream << '\n';
+		}
+	}
+}
\ No newline at end of file
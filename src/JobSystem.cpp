@@ -0,0 +1,171 @@
+#include "JobSystem.h"
+
+#include <stdexcept>
+
+namespace wasp::jobs {
+
+	namespace {
+		//the worker's own deque, valid only in the system that owns the worker;
+		//a worker calling into another system uses that system's first deque
+		//like any other outside thread
+		thread_local const JobSystem* currentOwner{};
+		thread_local std::size_t currentQueueIndex{ 0 };
+
+		std::size_t getQueueIndex(const JobSystem* jobSystem) {
+			return currentOwner == jobSystem ? currentQueueIndex : 0;
+		}
+	}
+
+	JobSystem::JobSystem(std::size_t workerCount) {
+		queues.reserve(workerCount + 1);
+		for (std::size_t i{ 0 }; i < workerCount + 1; ++i) {
+			queues.push_back(std::make_unique<JobQueue>());
+		}
+		running = true;
+		workers.reserve(workerCount);
+		for (std::size_t i{ 1 }; i <= workerCount; ++i) {
+			workers.emplace_back([this, i] { workerLoop(i); });
+		}
+	}
+
+	JobSystem::~JobSystem() {
+		{
+			std::lock_guard<std::mutex> lock{ sleepMutex };
+			running = false;
+		}
+		sleepCondition.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	void JobSystem::run(JobCounter& counter, jobFunctionType job) {
+		if (!job) {
+			throw std::invalid_argument{ "Error running empty job" };
+		}
+		counter.pendingJobs.fetch_add(1, std::memory_order_relaxed);
+		push({ std::move(job), &counter });
+	}
+
+	void JobSystem::parallelFor(
+		JobCounter& counter,
+		std::size_t begin,
+		std::size_t end,
+		std::size_t grainSize,
+		const rangeFunctionType& function
+	) {
+		if (grainSize == 0) {
+			throw std::invalid_argument{ "Error parallelFor grainSize 0" };
+		}
+		for (std::size_t chunkBegin{ begin }; chunkBegin < end; chunkBegin += grainSize) {
+			const std::size_t chunkEnd{ 
+				end - chunkBegin > grainSize ? chunkBegin + grainSize : end 
+			};
+			run(counter, [&function, chunkBegin, chunkEnd] { 
+				function(chunkBegin, chunkEnd); 
+			});
+		}
+	}
+
+	void JobSystem::parallelFor(
+		std::size_t begin,
+		std::size_t end,
+		std::size_t grainSize,
+		const rangeFunctionType& function
+	) {
+		JobCounter counter{};
+		parallelFor(counter, begin, end, grainSize, function);
+		wait(counter);
+	}
+
+	void JobSystem::wait(const JobCounter& counter) {
+		Job job{};
+		while (!counter.isDone()) {
+			if (popOrSteal(job)) {
+				execute(job);
+			}
+			else {
+				//the last jobs are running elsewhere
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	std::size_t JobSystem::getDefaultWorkerCount() {
+		const unsigned int cores{ std::thread::hardware_concurrency() };
+		return cores > 1 ? cores - 1 : 0;
+	}
+
+	void JobSystem::push(Job&& job) {
+		//counted first so the count never dips below what is really queued
+		queuedJobCount.fetch_add(1);
+		JobQueue& queue{ *queues[getQueueIndex(this)] };
+		{
+			std::lock_guard<std::mutex> lock{ queue.mutex };
+			queue.jobs.push_back(std::move(job));
+		}
+		//only take the lock if someone may be between checking for work and
+		//sleeping, otherwise the wake up could be missed
+		if (sleepingWorkerCount.load() > 0) {
+			{
+				std::lock_guard<std::mutex> lock{ sleepMutex };
+			}
+			sleepCondition.notify_one();
+		}
+	}
+
+	bool JobSystem::popOrSteal(Job& job) {
+		if (queuedJobCount.load(std::memory_order_relaxed) == 0) {
+			return false;
+		}
+		const std::size_t queueIndex{ getQueueIndex(this) };
+		//newest from our own deque, it is the most likely to be in cache
+		{
+			JobQueue& queue{ *queues[queueIndex] };
+			std::lock_guard<std::mutex> lock{ queue.mutex };
+			if (!queue.jobs.empty()) {
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+				queuedJobCount.fetch_sub(1);
+				return true;
+			}
+		}
+		//oldest from everyone else's, starting with the next deque over
+		for (std::size_t i{ 1 }; i < queues.size(); ++i) {
+			JobQueue& queue{ *queues[(queueIndex + i) % queues.size()] };
+			std::lock_guard<std::mutex> lock{ queue.mutex };
+			if (!queue.jobs.empty()) {
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+				queuedJobCount.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void JobSystem::execute(Job& job) {
+		job.function();
+		job.function = nullptr;
+		job.counter->pendingJobs.fetch_sub(1, std::memory_order_release);
+	}
+
+	void JobSystem::workerLoop(std::size_t queueIndex) {
+		currentOwner = this;
+		currentQueueIndex = queueIndex;
+		Job job{};
+		while (running.load(std::memory_order_relaxed)) {
+			if (popOrSteal(job)) {
+				execute(job);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock{ sleepMutex };
+			sleepingWorkerCount.fetch_add(1);
+			sleepCondition.wait(lock, [&] {
+				return !running.load(std::memory_order_relaxed) 
+					|| queuedJobCount.load() > 0;
+			});
+			sleepingWorkerCount.fetch_sub(1);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "Log.h"
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace wasp::log {
+
+	namespace {
+		constexpr std::chrono::milliseconds flushPeriod{ 10 };
+
+		struct LoggerState {
+			std::mutex mutex{};
+			std::condition_variable stopCondition{};
+			std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers{};
+			std::ostream* outStreamPointer{};
+			std::thread formatThread{};
+			bool running{};
+			uint64_t reportedDroppedCount{};
+			time::TscClock::time_point startTime{ time::TscClock::now() };
+		};
+
+		//never destroyed, threads can still log during static destruction
+		LoggerState& getState() {
+			static LoggerState* statePointer{ new LoggerState{} };
+			return *statePointer;
+		}
+
+		const char* getLevelName(Level level) {
+			switch (level) {
+				case Level::trace:
+					return "trace";
+				case Level::debug:
+					return "debug";
+				case Level::info:
+					return "info ";
+				case Level::warning:
+					return "warn ";
+				case Level::error:
+					return "error";
+			}
+			return "?    ";
+		}
+
+		void appendArgument(std::string& line, const Argument& argument) {
+			char buffer[32]{};
+			switch (argument.index()) {
+				case 0:
+					line += std::get<bool>(argument) ? "true" : "false";
+					return;
+				case 1:
+					line += std::get<char>(argument);
+					return;
+				case 2:
+					std::snprintf(
+						buffer, 
+						sizeof(buffer), 
+						"%lld", 
+						static_cast<long long>(std::get<int64_t>(argument))
+					);
+					break;
+				case 3:
+					std::snprintf(
+						buffer,
+						sizeof(buffer),
+						"%llu",
+						static_cast<unsigned long long>(std::get<uint64_t>(argument))
+					);
+					break;
+				case 4:
+					std::snprintf(buffer, sizeof(buffer), "%g", std::get<double>(argument));
+					break;
+				case 5: {
+					const char* string{ std::get<const char*>(argument) };
+					line += string ? string : "(null)";
+					return;
+				}
+			}
+			line += buffer;
+		}
+
+		void appendRecord(
+			std::string& out,
+			const Record& record,
+			time::TscClock::time_point startTime
+		) {
+			char prefix[48]{};
+			std::snprintf(
+				prefix,
+				sizeof(prefix),
+				"[%12.6f] %s t%u ",
+				std::chrono::duration<double>{ record.time - startTime }.count(),
+				getLevelName(record.level),
+				static_cast<unsigned>(record.threadIndex)
+			);
+			out += prefix;
+
+			std::size_t argumentIndex{ 0 };
+			for (const char* current{ record.format }; *current; ++current) {
+				if (current[0] == '{' && current[1] == '}' 
+					&& argumentIndex < record.argumentCount
+				) {
+					appendArgument(out, record.arguments[argumentIndex++]);
+					++current;
+				}
+				else {
+					out += *current;
+				}
+			}
+			out += '\n';
+		}
+
+		//drains every ring once, returns false if nothing was there
+		bool formatPending(
+			LoggerState& state, 
+			std::vector<Record>& records, 
+			std::string& out
+		) {
+			std::vector<ThreadBuffer*> threadBuffers{};
+			{
+				std::lock_guard<std::mutex> lock{ state.mutex };
+				threadBuffers.reserve(state.threadBuffers.size());
+				for (const std::unique_ptr<ThreadBuffer>& threadBuffer : state.threadBuffers) {
+					threadBuffers.push_back(threadBuffer.get());
+				}
+			}
+
+			records.clear();
+			uint64_t droppedCount{ 0 };
+			for (ThreadBuffer* threadBuffer : threadBuffers) {
+				const std::size_t available{ threadBuffer->records.size() };
+				const std::size_t oldSize{ records.size() };
+				records.resize(oldSize + available);
+				records.resize(
+					oldSize + threadBuffer->records.read(records.data() + oldSize, available)
+				);
+				droppedCount += threadBuffer->droppedCount.load(std::memory_order_relaxed);
+			}
+			//each ring is in order already, this interleaves the threads
+			std::stable_sort(
+				records.begin(), 
+				records.end(), 
+				[](const Record& a, const Record& b) { return a.time < b.time; }
+			);
+
+			out.clear();
+			for (const Record& record : records) {
+				appendRecord(out, record, state.startTime);
+			}
+			if (droppedCount > state.reportedDroppedCount) {
+				out += "log dropped ";
+				out += std::to_string(droppedCount - state.reportedDroppedCount);
+				out += " records\n";
+				state.reportedDroppedCount = droppedCount;
+			}
+			if (out.empty()) {
+				return false;
+			}
+			state.outStreamPointer->write(out.data(), out.size());
+			state.outStreamPointer->flush();
+			return true;
+		}
+
+		void formatLoop(LoggerState& state) {
+			std::vector<Record> records{};
+			std::string out{};
+			std::unique_lock<std::mutex> lock{ state.mutex };
+			while (state.running) {
+				lock.unlock();
+				formatPending(state, records, out);
+				lock.lock();
+				state.stopCondition.wait_for(lock, flushPeriod, [&] { return !state.running; });
+			}
+			lock.unlock();
+			//whatever was logged before stop
+			formatPending(state, records, out);
+		}
+	}
+
+	void start(std::ostream& outStream) {
+		LoggerState& state{ getState() };
+		std::lock_guard<std::mutex> lock{ state.mutex };
+		if (state.running) {
+			return;
+		}
+		state.outStreamPointer = &outStream;
+		state.running = true;
+		state.formatThread = std::thread{ formatLoop, std::ref(state) };
+	}
+
+	void stop() {
+		LoggerState& state{ getState() };
+		{
+			std::lock_guard<std::mutex> lock{ state.mutex };
+			if (!state.running) {
+				return;
+			}
+			state.running = false;
+		}
+		state.stopCondition.notify_all();
+		state.formatThread.join();
+	}
+
+	uint64_t getDroppedCount() {
+		LoggerState& state{ getState() };
+		std::lock_guard<std::mutex> lock{ state.mutex };
+		uint64_t droppedCount{ 0 };
+		for (const std::unique_ptr<ThreadBuffer>& threadBuffer : state.threadBuffers) {
+			droppedCount += threadBuffer->droppedCount.load(std::memory_order_relaxed);
+		}
+		return droppedCount;
+	}
+
+	//buffers are kept after their thread exits, whatever is left in them still
+	//gets written
+	ThreadBuffer& registerThread() {
+		LoggerState& state{ getState() };
+		std::lock_guard<std::mutex> lock{ state.mutex };
+		state.threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+		ThreadBuffer& threadBuffer{ *state.threadBuffers.back() };
+		threadBuffer.threadIndex = static_cast<uint32_t>(state.threadBuffers.size() - 1);
+		return threadBuffer;
+	}
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 //todo: midi test
 #include <ios>
+#include <iostream>
 #include <fstream>
 #include <thread>
 
@@ -12,6 +13,7 @@
 #include "Config.h"
 #include "WindowUtil.h"
 #include "ComLibraryGuard.h"
+#include "TimerResolutionGuard.h"
 #include "BitmapConstructor.h"
 #include "BaseWindow.h"
 #include "MainWindow.h"
@@ -20,6 +22,15 @@
 #include "MidiSequencer.h"
 #include "GameLoop.h"
 #include "MidiSequence.h"
+#include "StateSnapshotBuffer.h"
+#include "DrawList.h"
+#include "RenderThread.h"
+#include "HitchDetector.h"
+#include "TscClock.h"
+#include "TimerService.h"
+#include "JobSystem.h"
+#include "TaskGraph.h"
+#include "Log.h"
 
 #ifdef _DEBUG
 #include "Debug.h"
@@ -44,6 +55,20 @@ int WINAPI wWinMain(HINSTANCE instanceHandle, HINSTANCE, PWSTR, int windowShowMo
     win32adaptor::ComLibraryGuard comLibraryGuard{};
     comLibraryGuard.init(COINIT_APARTMENTTHREADED);
 
+    //1ms sleeps for frame pacing
+    win32adaptor::TimerResolutionGuard timerResolutionGuard{};
+    timerResolutionGuard.init(1);
+
+    //before any other thread is running
+    time::TscClock::calibrate();
+
+    //log records are written to the console by a background thread
+    log::start(std::cout);
+
+    //one timing thread for everything that waits on a deadline
+    time::TimerService timerService{};
+    timerService.start();
+
     //init Resources : WIC graphics
     graphics::BitmapConstructor bitmapConstructorPointer{};
     bitmapConstructorPointer.init();
@@ -51,14 +76,16 @@ int WINAPI wWinMain(HINSTANCE instanceHandle, HINSTANCE, PWSTR, int windowShowMo
     gameresource::ResourceMasterStorage resourceMasterStorage{
         gameresource::DirectoryStorage{},
         gameresource::ManifestStorage{},
-        gameresource::BitmapStorage{&bitmapConstructorPointer}
+        gameresource::BitmapStorage{&bitmapConstructorPointer},
+        gameresource::WaveStorage{}
     };
 
     resource::ResourceLoader resourceLoader{
-        std::array<resource::Loadable*, 3>{
+        std::array<resource::Loadable*, 4>{
             &resourceMasterStorage.directoryStorage,
             &resourceMasterStorage.manifestStorage,
-            &resourceMasterStorage.bitmapStorage
+            &resourceMasterStorage.bitmapStorage,
+            &resourceMasterStorage.waveStorage
         }
     };
     //resourceLoader.loadFile({ L"res" }); //test image in res
@@ -98,6 +125,15 @@ int WINAPI wWinMain(HINSTANCE instanceHandle, HINSTANCE, PWSTR, int windowShowMo
     resourceMasterStorage.bitmapStorage.setRenderTargetPointerAndLoadD2DBitmaps(
         window.getWindowPainter().getRenderTargetPointer()
     );
+    resourceMasterStorage.bitmapStorage.buildAtlases(
+        config::atlasPageSize, 
+        config::atlasPadding
+    );
+    log::info(
+        "packed bitmaps into {} atlases, {} efficient",
+        resourceMasterStorage.bitmapStorage.getAtlasCount(),
+        resourceMasterStorage.bitmapStorage.getAtlasEfficiency()
+    );
 
     //init input
     input::KeyInputTable keyInputTable{};
@@ -107,92 +143,154 @@ int WINAPI wWinMain(HINSTANCE instanceHandle, HINSTANCE, PWSTR, int windowShowMo
     window.setKeyUpCallback([&](WPARAM wParam, LPARAM lParam) {
         keyInputTable.handleKeyUp(wParam, lParam);
     });
-    window.setOutOfFocusCallback([&] {keyInputTable.allKeysOff(); });
-
-    ShowWindow(window.getWindowHandle(), windowShowMode);
 
     static int updateCount{ 0 };
 
-    gameloop::GameLoop gameLoop {
+    //writes the frames around any long frame out to a file
+    debug::HitchDetector hitchDetector{
+        config::hitchHistoryFrames,
+        std::chrono::duration<double>{ config::hitchThresholdSeconds },
+        config::hitchFramesAfter,
+        config::hitchDumpFilePrefix
+    };
+
+    //all d2d drawing and presenting happens on the render thread from here on
+    window::RenderThread renderThread{
+        window.getWindowPainter(),
+        window.getWindowHandle()
+    };
+    renderThread.setHitchDetector(&hitchDetector);
+    //images loaded or reloaded from here on get their d2d bitmaps made here
+    renderThread.setBetweenFramesCallback([&] {
+        resourceMasterStorage.bitmapStorage.createQueuedD2DBitmaps();
+    });
+    //requests made before start are applied on the first wake
+    window.setPaintCallback([&] { renderThread.requestPresent(); });
+    window.setResizeCallback([&] { renderThread.requestResize(); });
+
+    //test sprite spins one degree per update, drawn interpolated
+    float spriteRotation{ 0.0f };
+    StateSnapshotBuffer<float> spriteRotationSnapshots{ spriteRotation };
+
+    //update work declares what it touches instead of relying on call order,
+    //independent tasks run in parallel
+    jobs::JobSystem jobSystem{};
+    jobs::TaskGraph updateGraph{};
+    updateGraph.addTask("input", {}, { "keyInputTable" }, [&] {
+        keyInputTable.tickOver();
+    });
+    updateGraph.addTask("updateCount", {}, { "updateCount" }, [&] {
+        ++updateCount;
+    });
+    updateGraph.addTask("sprite", {}, { "spriteRotation" }, [&] {
+        spriteRotation += 1.0f;
+        spriteRotationSnapshots.publish(spriteRotation);
+    });
+    updateGraph.build();
+
+    auto gameLoop{ gameloop::makeGameLoop<gameloop::TscClock>(
         config::updatesPerSecond,
         config::maxUpdatesWithoutFrame,
+        config::maxFramesPerSecond,
         //update function
         [&] {
-            ++updateCount;
-            keyInputTable.tickOver();
+            updateGraph.run(jobSystem);
+            //window messages have to be handled on this thread, and they write
+            //to the key input table, so the pump stays out of the graph
+            debug::HitchDetector::PhaseScope pumpScope{
+                &hitchDetector,
+                debug::FramePhase::messagePump
+            };
             pumpMessages();
         },
-        //draw function
-        [&](double dt) {
-            static bool waitingForVsync{false};
-
-            static constexpr double smoothing{ 0.9 };
-
+        //draw function, records the frame for the render thread
+        [&](double alpha) {
             static int frameCount{ 0 };
 
-            static std::chrono::steady_clock::time_point lastDraw{};
-            static std::chrono::steady_clock::time_point thisDraw{};
-
-            static double timeToDraw{ 1.0 };
-            static double fps{ 1.0 };
-
-            if (waitingForVsync) {
-                return;
-            }
-
-            window.getWindowPainter().beginDraw();
-            window.getWindowPainter().drawSubBitmap(
+            const float interpolatedRotation{
+                spriteRotationSnapshots.interpolate(
+                    alpha,
+                    [](float previous, float current, double amount) {
+                        return static_cast<float>(
+                            previous + (current - previous) * amount
+                        );
+                    }
+                )
+            };
+
+            graphics::DrawList& drawList{ renderThread.getDrawList() };
+            drawList.beginDraw();
+            const gameresource::AtlasRegion testImage{
+                resourceMasterStorage.bitmapStorage.getAtlasRegion(L"timage")
+            };
+            drawList.drawSubBitmap(
                 { config::graphicsWidth / 2, config::graphicsHeight / 2 },
                 {
-                    resourceMasterStorage.bitmapStorage.get(L"timage")->d2dBitmap,
-                    45.0f,
+                    testImage.bitmap,
+                    interpolatedRotation,
                     .8f,
                     .7f
                 },
-                { 100, 100, 600, 400 }
+                testImage.getSubRectangle({ 100, 100, 600, 400 })
             );
-            window.getWindowPainter().drawText(
+            drawList.drawText(
                 { 20.0, 10.0 },
                 { std::to_wstring(updateCount) },
                 { 300.0f, 500.0f }
             );
-            window.getWindowPainter().drawText(
+            drawList.drawText(
                 { 20.0, 30.0 },
                 { std::to_wstring(frameCount++) },
                 { 300.0f, 500.0f }
             );
-            window.getWindowPainter().drawText(
+            drawList.drawText(
                 { 20.0f, 50.0f },
-                { std::to_wstring(1.0/fps) },
+                { std::to_wstring(1.0 / renderThread.getAverageFrameSeconds()) },
                 { 400.0f, 300.0f }
             );
-            window.getWindowPainter().drawText(
+            drawList.drawText(
                 { 20.0f, 70.0f },
                 { std::to_wstring(static_cast<int>(keyInputTable[input::KeyValues::K_Z])) },
                 { 400.0f, 300.0f }
             );
-            window.getWindowPainter().endDraw();
-
-            waitingForVsync = true;
+            const window::WindowPainter& windowPainter{ window.getWindowPainter() };
+            drawList.drawText(
+                { 20.0f, 110.0f },
+                {
+                    L"drawn " + std::to_wstring(windowPainter.getLastFrameDrawnCount())
+                    + L" culled " + std::to_wstring(windowPainter.getLastFrameCulledCount())
+                },
+                { 400.0f, 300.0f }
+            );
+            const std::string criticalPath{ updateGraph.formatCriticalPath() };
+            drawList.drawText(
+                { 20.0f, 90.0f },
+                { std::wstring{ criticalPath.begin(), criticalPath.end() } },
+                { 800.0f, 300.0f }
+            );
+            drawList.endDraw();
+            renderThread.submit();
+        }
+    ) };
 
-            std::thread render{ [&] {
-                window.getWindowPainter().paint(window.getWindowHandle());
-                lastDraw = thisDraw;
-                thisDraw = std::chrono::steady_clock::now();
+    gameLoop.setHitchDetector(&hitchDetector);
+    gameLoop.setTimerService(&timerService);
 
-                auto duration{ thisDraw - lastDraw };
-                timeToDraw = duration.count()
-                    * static_cast<double>(std::chrono::steady_clock::period::num)
-                    / std::chrono::steady_clock::period::den;
+    window.setDestroyCallback([&] {
+        //stop presenting while the window handle is still valid
+        renderThread.stop();
+        gameLoop.stop();
+    });
 
-                fps = (fps * smoothing) + (timeToDraw * (1.0 - smoothing));
-                waitingForVsync = false;
-             } };
-            render.detach();
-        }
-    };
+    //pause the game but keep pumping messages while in the background
+    gameLoop.setThrottledFunction(config::throttledUpdatesPerSecond, pumpMessages);
+    window.setOutOfFocusCallback([&] {
+        keyInputTable.allKeysOff();
+        gameLoop.throttle();
+    });
+    window.setInFocusCallback([&] {gameLoop.unthrottle(); });
 
-    window.setDestroyCallback([&] {gameLoop.stop(); });
+    ShowWindow(window.getWindowHandle(), windowShowMode);
 
     //midi test
     std::ifstream inStream{ L"res\\example6.mid", std::ios::binary };
@@ -201,11 +299,16 @@ int WINAPI wWinMain(HINSTANCE instanceHandle, HINSTANCE, PWSTR, int windowShowMo
     inStream.close();
 
     sound::midi::MidiSequencer midiSequencer{};
-    std::thread soundTest{ [&] {midiSequencer.test(sequence); } };
+    std::thread soundTest{ [&] {midiSequencer.test(sequence, timerService); } };
     soundTest.detach();
     //end midi test
 
+    renderThread.start();
     gameLoop.run();
+    renderThread.stop();
+    //releases the midi test if it is still waiting
+    timerService.stop();
+    log::stop();
 
     return 0;
 }
@@ -223,4 +326,4 @@ void pumpMessages() {
         TranslateMessage(&msg);
         DispatchMessage(&msg);
     }
-}
+}
\ No newline at end of file
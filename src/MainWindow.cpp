@@ -9,12 +9,25 @@ namespace wasp::window {
 				windowPainter.init(windowHandle);
 				return 0;
 
+			//once the render thread owns the painter these only forward a request
 			case WM_PAINT:
-				windowPainter.paint(windowHandle);
+				ValidateRect(windowHandle, NULL);
+				if (paintCallback) {
+					paintCallback();
+				}
+				else {
+					windowPainter.present(windowHandle);
+				}
 				return 0;
 
 			case WM_SIZE:
-				windowPainter.resize(windowHandle);
+				if (resizeCallback) {
+					resizeCallback();
+				}
+				else {
+					windowPainter.resize(windowHandle);
+					windowPainter.present(windowHandle);
+				}
 				return 0;
 				
 			case WM_KEYDOWN:
@@ -29,6 +42,11 @@ namespace wasp::window {
 			case WM_ENTERSIZEMOVE:
 				outOfFocusCallback();
 				return 0;
+
+			case WM_SETFOCUS:
+			case WM_EXITSIZEMOVE:
+				inFocusCallback();
+				return 0;
 		
 			case WM_DESTROY:
 				destroyCallback();
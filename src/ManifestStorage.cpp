@@ -9,10 +9,12 @@ namespace wasp::game::gameresource {
 
 	void ManifestStorage::reload(const std::wstring& id) {
 		if (resourceLoaderPointer) {
-			auto found{ resourceMap.find(id) };
-			if (found != resourceMap.end()) {
+			std::shared_ptr<resource::Resource<resource::ChildList>> resourcePointer{
+				findResource(id)
+			};
+			if (resourcePointer) {
 				const resource::ResourceOriginVariant origin{
-					std::get<1>(*found)->getOrigin()
+					resourcePointer->getOrigin()
 				};
 				switch (origin.index()) {
 					case 0: {
@@ -90,7 +92,7 @@ namespace wasp::game::gameresource {
 		);
 
 		const std::wstring& id{ file::getFileName(fileOrigin.fileName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
@@ -108,7 +110,7 @@ namespace wasp::game::gameresource {
 
 		resourceSharedPointer->setStoragePointer(this);
 
-		resourceMap.insert({ id, resourceSharedPointer });
+		insertResource(id, resourceSharedPointer);
 		return resourceSharedPointer.get();
 	}
 
@@ -128,7 +130,7 @@ namespace wasp::game::gameresource {
 		);
 
 		const std::wstring& id{ file::getFileName(fileName) };
-		if (resourceMap.find(id) != resourceMap.end()) {
+		if (findResource(id)) {
 			throw std::runtime_error{ "Error loaded pre-existing id" };
 		}
 
@@ -146,7 +148,7 @@ namespace wasp::game::gameresource {
 
 		resourceSharedPointer->setStoragePointer(this);
 
-		resourceMap.insert({ id, resourceSharedPointer });
+		insertResource(id, resourceSharedPointer);
 		return resourceSharedPointer.get();
 	}
 }
\ No newline at end of file
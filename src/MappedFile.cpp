@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#include "FileError.h"
+
+namespace wasp::file {
+
+	MappedFile::MappedFile(const std::wstring& fileName) {
+		fileHandle = CreateFileW(
+			fileName.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			NULL,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			NULL
+		);
+		if (fileHandle == INVALID_HANDLE_VALUE) {
+			throw FileError{ "Error opening file for mapping" };
+		}
+
+		LARGE_INTEGER largeFileSize{};
+		if (!GetFileSizeEx(fileHandle, &largeFileSize)) {
+			close();
+			throw FileError{ "Error retrieving size of mapped file" };
+		}
+		fileSize = static_cast<std::size_t>(largeFileSize.QuadPart);
+
+		//cannot map an empty file, leave the view null
+		if (fileSize == 0) {
+			return;
+		}
+
+		mappingHandle = CreateFileMappingW(
+			fileHandle, 
+			NULL, 
+			PAGE_READONLY, 
+			0, 
+			0, 
+			NULL
+		);
+		if (!mappingHandle) {
+			close();
+			throw FileError{ "Error creating file mapping" };
+		}
+
+		viewPointer = static_cast<const std::byte*>(
+			MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0)
+		);
+		if (!viewPointer) {
+			close();
+			throw FileError{ "Error mapping view of file" };
+		}
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: fileHandle{ std::exchange(other.fileHandle, INVALID_HANDLE_VALUE) }
+		, mappingHandle{ std::exchange(other.mappingHandle, nullptr) }
+		, viewPointer{ std::exchange(other.viewPointer, nullptr) }
+		, fileSize{ std::exchange(other.fileSize, 0) } {
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			close();
+			fileHandle = std::exchange(other.fileHandle, INVALID_HANDLE_VALUE);
+			mappingHandle = std::exchange(other.mappingHandle, nullptr);
+			viewPointer = std::exchange(other.viewPointer, nullptr);
+			fileSize = std::exchange(other.fileSize, 0);
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	void MappedFile::close() noexcept {
+		if (viewPointer) {
+			UnmapViewOfFile(viewPointer);
+			viewPointer = nullptr;
+		}
+		if (mappingHandle) {
+			CloseHandle(mappingHandle);
+			mappingHandle = nullptr;
+		}
+		if (fileHandle != INVALID_HANDLE_VALUE) {
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+		}
+		fileSize = 0;
+	}
+}
\ No newline at end of file
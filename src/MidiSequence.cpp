@@ -1,11 +1,11 @@
 #include "MidiSequence.h"
 
-#include <iostream>
 #include <limits>
 
 #include "ByteSwap.h"
 #include "MidiConstants.h"
 #include "compiler.h"
+#include "Log.h"
 
 namespace wasp::sound::midi {
 
@@ -312,7 +312,7 @@ namespace wasp::sound::midi {
 				}
 			}
 
-			std::cout << "lowest delta time: " << lowestDeltaTime << '\n';
+			log::trace("lowest delta time: {}", lowestDeltaTime);
 
 			//todo: loop meta events go here
 			
@@ -10,6 +10,7 @@
 
 #include "MidiConstants.h"
 #include "ByteSwap.h"
+#include "Log.h"
 
 namespace wasp::sound::midi {
 
@@ -24,7 +25,6 @@ namespace wasp::sound::midi {
 		if (result != MMSYSERR_NOERROR) {
 			throw std::runtime_error{ "Error opening MIDI Mapper" };
 		}
-		while (!QueryPerformanceFrequency(&performanceFrequency));
 	}
 	
 	MidiSequencer::~MidiSequencer(){
@@ -50,7 +50,7 @@ namespace wasp::sound::midi {
 		}
 	}
 
-	void MidiSequencer::test(MidiSequence& midiSequence) {
+	void MidiSequencer::test(MidiSequence& midiSequence, time::TimerService& timerService) {
 		uint32_t microsecondsPerBeat{ defaultMicrosecondsPerBeat };
 		if (midiSequence.ticks & (0b1 << 15)) {
 			throw std::runtime_error{ "Error does not support MIDI FPS" };
@@ -59,34 +59,30 @@ namespace wasp::sound::midi {
 			(10 * microsecondsPerBeat) / midiSequence.ticks 
 		};
 
-		LARGE_INTEGER prevTimeStamp{};
-		while (!QueryPerformanceCounter(&prevTimeStamp));
-		LARGE_INTEGER currentTimeStamp{};
-		LONGLONG previousHundredNanosecondSleepDuration{ 0 };
+		//events are timed from the start, so lateness never accumulates
+		time::TimerService::timePointType nextEventTime{ timerService.now() };
 
 		auto iter{ midiSequence.compiledTrack.begin() };
 		auto endIter{ midiSequence.compiledTrack.end() };
 		while (iter != endIter) {
 			//sleep for delta time
 			if ((*iter).deltaTime != 0) {
-				LONGLONG hundredNanosecondSleepDuration{
-					static_cast<LONGLONG>((*iter).deltaTime)
-					* hundredNanosecondsPerTick
-				};
-				if (QueryPerformanceCounter(&currentTimeStamp)) {
-					LONGLONG timeElapsed{ 
-							currentTimeStamp.QuadPart - prevTimeStamp.QuadPart
-					};
-					prevTimeStamp = currentTimeStamp;
-					(timeElapsed *= 10'000'000ll) /= performanceFrequency.QuadPart;
-					LONGLONG timeLost{
-						timeElapsed - previousHundredNanosecondSleepDuration
-					};
-					std::cout << "lost:" << (timeLost / 10'000'000.0) << "s\n";
-					hundredNanosecondSleepDuration -= timeLost;
+				nextEventTime += std::chrono::duration_cast<time::TimerService::durationType>(
+					std::chrono::nanoseconds{
+						static_cast<int64_t>((*iter).deltaTime) 
+							* hundredNanosecondsPerTick 
+							* 100
+					}
+				);
+				if (!timerService.sleepUntil(nextEventTime)) {
+					return;
+				}
+				//reading the clock isn't free, so only when the level is on
+				if constexpr (log::isEnabled(log::Level::debug)) {
+					log::debug("late: {}s", std::chrono::duration<double>{
+						timerService.now() - nextEventTime
+					}.count());
 				}
-				hundredNanosecondSleep(hundredNanosecondSleepDuration);
-				previousHundredNanosecondSleepDuration = hundredNanosecondSleepDuration;
 			}
 			//midi event
 			if (((*iter).event & 0xF0) != 0xF0) {
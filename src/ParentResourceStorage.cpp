@@ -5,29 +5,53 @@ namespace wasp::resource {
 	using ResourceType = Resource<ChildList>;
 
 	ChildListResource::~ChildListResource() {
-		//erase children first
-		for (auto& childPointer : *dataPointer) {
-			childPointer->setParentPointer(nullptr);
+		//erase children first, the list itself is left alone since readers
+		//may still hold it
+		const std::shared_ptr<ChildList> childList{ getDataPointerCopy() };
+		if (childList) {
+			for (ResourceBase* childPointer : *childList) {
+				childPointer->setParentPointer(nullptr);
+			}
 		}
-		dataPointer->clear();
 
 		//remove self from parent in IResource destructor
 	}
 
+	//copy on write, so anyone walking the list keeps a whole one; retried if
+	//another thread swapped in a new list meanwhile
 	void ChildListResource::removeChild(ResourceBase* child) {
-		auto found{ std::find(dataPointer->begin(), dataPointer->end(), child) };
-		if (found != dataPointer->end()) {
-			dataPointer->erase(found);
-		}
-		else {
-			throw std::runtime_error("Error removeChild called on non child");
+		std::shared_ptr<ChildList> childList{ getDataPointerCopy() };
+		while (childList) {
+			auto found{ std::find(childList->begin(), childList->end(), child) };
+			if (found == childList->end()) {
+				throw std::runtime_error("Error removeChild called on non child");
+			}
+			std::shared_ptr<ChildList> newChildList{
+				std::make_shared<ChildList>(*childList)
+			};
+			newChildList->erase(
+				newChildList->begin() + (found - childList->begin())
+			);
+			if (std::atomic_compare_exchange_weak(
+				&dataPointer, 
+				&childList, 
+				newChildList
+			)) {
+				return;
+			}
 		}
+		//unloaded, there is no list to remove from
 	}
 
+	//children remove themselves from the list while this walks it, so it
+	//holds on to the list it started with
 	static void unloadChildren(ResourceType& resource) {
-		ChildList& childList{ *resource.getDataPointerCopy() };
+		const std::shared_ptr<ChildList> childList{ resource.getDataPointerCopy() };
+		if (!childList) {
+			return;
+		}
 
-		for (ResourceBase* childPointer : childList) {
+		for (ResourceBase* childPointer : *childList) {
 			if (childPointer->isLoaded()) {
 				const std::wstring& childID{ childPointer->getID() };
 				childPointer->getStoragePointer()->unload(childID);
@@ -36,11 +60,9 @@ namespace wasp::resource {
 	}
 
 	void ParentResourceStorage::unload(const std::wstring& id) {
-		auto found{ resourceMap.find(id) };
-		if (found != resourceMap.end()) {
-			Resource<ChildList>& resource{
-				*(std::get<1>(*found))
-			};
+		std::shared_ptr<ResourceType> resourcePointer{ findResource(id) };
+		if (resourcePointer) {
+			ResourceType& resource{ *resourcePointer };
 
 			if (resource.isLoaded()) {
 				unloadChildren(resource);
@@ -50,9 +72,12 @@ namespace wasp::resource {
 	}
 
 	static void removeChildren(ResourceType& resource) {
-		ChildList& childList{ *resource.getDataPointerCopy() };
+		const std::shared_ptr<ChildList> childList{ resource.getDataPointerCopy() };
+		if (!childList) {
+			return;
+		}
 
-		for (ResourceBase* childPointer : childList) {
+		for (ResourceBase* childPointer : *childList) {
 			if (childPointer->isLoaded()) {
 				const std::wstring& childID{ childPointer->getID() };
 				childPointer->getStoragePointer()->remove(childID);
@@ -61,15 +86,13 @@ namespace wasp::resource {
 	}
 
 	void ParentResourceStorage::remove(const std::wstring& id) {
-		auto found{ resourceMap.find(id) };
-		if (found != resourceMap.end()) {
-			Resource<ChildList>& resource{
-				*(std::get<1>(*found))
-			};
+		std::shared_ptr<ResourceType> resourcePointer{ findResource(id) };
+		if (resourcePointer) {
+			ResourceType& resource{ *resourcePointer };
 
 			if (resource.isLoaded()) {
 				removeChildren(resource);
-				resourceMap.erase(found);
+				eraseResource(id);
 			}
 		}
 	}
@@ -0,0 +1,764 @@
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <intrin.h>
+#include <immintrin.h>
+#define WASP_PIXEL_X86
+#define WASP_TARGET_AVX2
+#endif
+#endif
+
+#ifdef __GNUC__
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define WASP_PIXEL_X86
+//only the avx2 functions are built for avx2, the rest of the program isn't
+#define WASP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace wasp::graphics::pixel {
+
+	namespace {
+
+		//scalar reference, one channel at a time
+
+		uint32_t getChannel(uint32_t pixel, int channel) {
+			return (pixel >> (channel * 8)) & 0xFF;
+		}
+
+		uint32_t modulatePixel(uint32_t pixel, uint32_t amount) {
+			uint32_t toRet{ 0 };
+			for (int channel{ 0 }; channel < 4; ++channel) {
+				toRet |= ((getChannel(pixel, channel) * amount) >> 8) << (channel * 8);
+			}
+			return toRet;
+		}
+
+		uint32_t blendPixel(uint32_t destination, uint32_t source) {
+			const uint32_t sourceAlpha{ source >> 24 };
+			const uint32_t inverseAlpha{ 256 - (sourceAlpha + (sourceAlpha >> 7)) };
+			uint32_t toRet{ 0 };
+			for (int channel{ 0 }; channel < 4; ++channel) {
+				const uint32_t value{
+					getChannel(source, channel)
+						+ ((getChannel(destination, channel) * inverseAlpha) >> 8)
+				};
+				toRet |= std::min(value, 255u) << (channel * 8);
+			}
+			return toRet;
+		}
+
+		//amount is 0 to 255
+		uint32_t lerpPixel(uint32_t a, uint32_t b, uint32_t amount) {
+			uint32_t toRet{ 0 };
+			for (int channel{ 0 }; channel < 4; ++channel) {
+				const uint32_t value{
+					(getChannel(a, channel) * (256 - amount) + getChannel(b, channel) * amount)
+						>> 8
+				};
+				toRet |= value << (channel * 8);
+			}
+			return toRet;
+		}
+
+		bool isInside(const SourceImage& source, int32_t u, int32_t v) {
+			return u >= source.left * fixedOne && u < source.right * fixedOne
+				&& v >= source.top * fixedOne && v < source.bottom * fixedOne;
+		}
+
+		//nothing inside, and nothing valid for the vector versions to clamp to
+		bool isEmpty(const SourceImage& source) {
+			return source.left >= source.right || source.top >= source.bottom;
+		}
+
+		uint32_t sampleNearestPixel(const SourceImage& source, int32_t u, int32_t v) {
+			if (!isInside(source, u, v)) {
+				return 0;
+			}
+			return source.pixels[
+				static_cast<std::size_t>(v >> 16) * source.stride + (u >> 16)
+			];
+		}
+
+		uint32_t sampleBilinearPixel(const SourceImage& source, int32_t u, int32_t v) {
+			if (!isInside(source, u, v)) {
+				return 0;
+			}
+			//texel centers are at +0.5
+			const int32_t sampleX{ u - fixedOne / 2 };
+			const int32_t sampleY{ v - fixedOne / 2 };
+			const int x0{ std::clamp(sampleX >> 16, source.left, source.right - 1) };
+			const int x1{ std::clamp((sampleX >> 16) + 1, source.left, source.right - 1) };
+			const int y0{ std::clamp(sampleY >> 16, source.top, source.bottom - 1) };
+			const int y1{ std::clamp((sampleY >> 16) + 1, source.top, source.bottom - 1) };
+			const uint32_t amountX{ static_cast<uint32_t>(sampleX >> 8) & 0xFF };
+			const uint32_t amountY{ static_cast<uint32_t>(sampleY >> 8) & 0xFF };
+
+			const uint32_t* row0{ source.pixels + static_cast<std::size_t>(y0) * source.stride };
+			const uint32_t* row1{ source.pixels + static_cast<std::size_t>(y1) * source.stride };
+			return lerpPixel(
+				lerpPixel(row0[x0], row0[x1], amountX),
+				lerpPixel(row1[x0], row1[x1], amountX),
+				amountY
+			);
+		}
+
+		void fillScalar(uint32_t* destination, std::size_t count, uint32_t color) {
+			std::fill(destination, destination + count, color);
+		}
+
+		void modulateScalar(
+			uint32_t* destination,
+			const uint32_t* source,
+			std::size_t count,
+			uint32_t amount
+		) {
+			for (std::size_t i{ 0 }; i < count; ++i) {
+				destination[i] = modulatePixel(source[i], amount);
+			}
+		}
+
+		void blendScalar(uint32_t* destination, const uint32_t* source, std::size_t count) {
+			for (std::size_t i{ 0 }; i < count; ++i) {
+				destination[i] = blendPixel(destination[i], source[i]);
+			}
+		}
+
+		void sampleNearestScalar(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			int32_t u{ span.u };
+			int32_t v{ span.v };
+			for (std::size_t i{ 0 }; i < count; ++i, u += span.stepU, v += span.stepV) {
+				destination[i] = sampleNearestPixel(source, u, v);
+			}
+		}
+
+		void sampleBilinearScalar(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			int32_t u{ span.u };
+			int32_t v{ span.v };
+			for (std::size_t i{ 0 }; i < count; ++i, u += span.stepU, v += span.stepV) {
+				destination[i] = sampleBilinearPixel(source, u, v);
+			}
+		}
+
+		//spans hand their leftover pixels to the scalar versions from here
+		AffineSpan advanceSpan(const AffineSpan& span, std::size_t count) {
+			return {
+				span.u + static_cast<int32_t>(count) * span.stepU,
+				span.v + static_cast<int32_t>(count) * span.stepV,
+				span.stepU,
+				span.stepV
+			};
+		}
+
+		constexpr Kernels scalarKernels{
+			InstructionSet::scalar,
+			fillScalar,
+			modulateScalar,
+			blendScalar,
+			sampleNearestScalar,
+			sampleBilinearScalar
+		};
+
+		#ifdef WASP_PIXEL_X86
+
+		//sse2, 4 pixels at a time
+		//channels are widened to 16 bit lanes so products up to 255 * 256 fit
+
+		//each pixel's 32 bit lane holds the same 16 bit value twice, unpacking
+		//this against itself lines it up with the widened channels
+		__m128i doubleWords(__m128i values) {
+			return _mm_or_si128(values, _mm_slli_epi32(values, 16));
+		}
+
+		__m128i modulate16(__m128i channels, __m128i amounts) {
+			return _mm_srli_epi16(_mm_mullo_epi16(channels, amounts), 8);
+		}
+
+		__m128i lerp16(__m128i a, __m128i b, __m128i amounts) {
+			const __m128i inverse{ _mm_sub_epi16(_mm_set1_epi16(256), amounts) };
+			return _mm_srli_epi16(
+				_mm_add_epi16(_mm_mullo_epi16(a, inverse), _mm_mullo_epi16(b, amounts)),
+				8
+			);
+		}
+
+		__m128i blend16(__m128i destination, __m128i source) {
+			const __m128i alpha{
+				_mm_shufflehi_epi16(_mm_shufflelo_epi16(source, 0xFF), 0xFF)
+			};
+			const __m128i inverse{ _mm_sub_epi16(
+				_mm_set1_epi16(256),
+				_mm_add_epi16(alpha, _mm_srli_epi16(alpha, 7))
+			) };
+			return _mm_add_epi16(source, modulate16(destination, inverse));
+		}
+
+		__m128i lerp4(__m128i a, __m128i b, __m128i amounts) {
+			const __m128i zero{ _mm_setzero_si128() };
+			const __m128i doubled{ doubleWords(amounts) };
+			const __m128i low{ lerp16(
+				_mm_unpacklo_epi8(a, zero),
+				_mm_unpacklo_epi8(b, zero),
+				_mm_unpacklo_epi32(doubled, doubled)
+			) };
+			const __m128i high{ lerp16(
+				_mm_unpackhi_epi8(a, zero),
+				_mm_unpackhi_epi8(b, zero),
+				_mm_unpackhi_epi32(doubled, doubled)
+			) };
+			return _mm_packus_epi16(low, high);
+		}
+
+		//no 32 bit min or max before sse4.1
+		__m128i clamp4(__m128i values, __m128i low, __m128i high) {
+			const __m128i belowLow{ _mm_cmplt_epi32(values, low) };
+			values = _mm_or_si128(_mm_and_si128(belowLow, low), _mm_andnot_si128(belowLow, values));
+			const __m128i aboveHigh{ _mm_cmpgt_epi32(values, high) };
+			return _mm_or_si128(_mm_and_si128(aboveHigh, high), _mm_andnot_si128(aboveHigh, values));
+		}
+
+		__m128i insideMask4(const SourceImage& source, __m128i u, __m128i v) {
+			const __m128i insideU{ _mm_and_si128(
+				_mm_cmpgt_epi32(u, _mm_set1_epi32(source.left * fixedOne - 1)),
+				_mm_cmplt_epi32(u, _mm_set1_epi32(source.right * fixedOne))
+			) };
+			const __m128i insideV{ _mm_and_si128(
+				_mm_cmpgt_epi32(v, _mm_set1_epi32(source.top * fixedOne - 1)),
+				_mm_cmplt_epi32(v, _mm_set1_epi32(source.bottom * fixedOne))
+			) };
+			return _mm_and_si128(insideU, insideV);
+		}
+
+		//lane i starts at start + i * step
+		__m128i makeLanePositions4(int32_t start, int32_t step) {
+			return _mm_setr_epi32(start, start + step, start + 2 * step, start + 3 * step);
+		}
+
+		__m128i gather4(const uint32_t* pixels, __m128i indices) {
+			alignas(16) int32_t lanes[4]{};
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices);
+			return _mm_set_epi32(
+				static_cast<int32_t>(pixels[lanes[3]]),
+				static_cast<int32_t>(pixels[lanes[2]]),
+				static_cast<int32_t>(pixels[lanes[1]]),
+				static_cast<int32_t>(pixels[lanes[0]])
+			);
+		}
+
+		//x + y * stride
+		__m128i makeIndices4(__m128i x, __m128i y, int stride) {
+			const __m128i strides{ _mm_set1_epi32(stride) };
+			//sse2 only multiplies even lanes, so do odd lanes separately
+			const __m128i even{ _mm_mul_epu32(y, strides) };
+			const __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(y, 32), strides) };
+			const __m128i rowOffsets{ _mm_unpacklo_epi32(
+				_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+				_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+			) };
+			return _mm_add_epi32(x, rowOffsets);
+		}
+
+		void fillSse2(uint32_t* destination, std::size_t count, uint32_t color) {
+			const __m128i colors{ _mm_set1_epi32(static_cast<int32_t>(color)) };
+			std::size_t i{ 0 };
+			for (; i + 4 <= count; i += 4) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), colors);
+			}
+			fillScalar(destination + i, count - i, color);
+		}
+
+		void modulateSse2(
+			uint32_t* destination,
+			const uint32_t* source,
+			std::size_t count,
+			uint32_t amount
+		) {
+			const __m128i zero{ _mm_setzero_si128() };
+			const __m128i amounts{ _mm_set1_epi16(static_cast<int16_t>(amount)) };
+			std::size_t i{ 0 };
+			for (; i + 4 <= count; i += 4) {
+				const __m128i pixels{
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))
+				};
+				const __m128i low{ modulate16(_mm_unpacklo_epi8(pixels, zero), amounts) };
+				const __m128i high{ modulate16(_mm_unpackhi_epi8(pixels, zero), amounts) };
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i*>(destination + i),
+					_mm_packus_epi16(low, high)
+				);
+			}
+			modulateScalar(destination + i, source + i, count - i, amount);
+		}
+
+		void blendSse2(uint32_t* destination, const uint32_t* source, std::size_t count) {
+			const __m128i zero{ _mm_setzero_si128() };
+			std::size_t i{ 0 };
+			for (; i + 4 <= count; i += 4) {
+				const __m128i sourcePixels{
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))
+				};
+				const __m128i destinationPixels{
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i))
+				};
+				const __m128i low{ blend16(
+					_mm_unpacklo_epi8(destinationPixels, zero),
+					_mm_unpacklo_epi8(sourcePixels, zero)
+				) };
+				const __m128i high{ blend16(
+					_mm_unpackhi_epi8(destinationPixels, zero),
+					_mm_unpackhi_epi8(sourcePixels, zero)
+				) };
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i*>(destination + i),
+					_mm_packus_epi16(low, high)
+				);
+			}
+			blendScalar(destination + i, source + i, count - i);
+		}
+
+		void sampleNearestSse2(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			if (isEmpty(source)) {
+				fillScalar(destination, count, 0);
+				return;
+			}
+			const __m128i stepU4{ _mm_set1_epi32(span.stepU * 4) };
+			const __m128i stepV4{ _mm_set1_epi32(span.stepV * 4) };
+			__m128i u{ makeLanePositions4(span.u, span.stepU) };
+			__m128i v{ makeLanePositions4(span.v, span.stepV) };
+			const __m128i left{ _mm_set1_epi32(source.left) };
+			const __m128i right{ _mm_set1_epi32(source.right - 1) };
+			const __m128i top{ _mm_set1_epi32(source.top) };
+			const __m128i bottom{ _mm_set1_epi32(source.bottom - 1) };
+
+			std::size_t i{ 0 };
+			for (; i + 4 <= count; i += 4) {
+				const __m128i inside{ insideMask4(source, u, v) };
+				//clamped so lanes outside the source still read valid memory
+				const __m128i x{ clamp4(_mm_srai_epi32(u, 16), left, right) };
+				const __m128i y{ clamp4(_mm_srai_epi32(v, 16), top, bottom) };
+				const __m128i pixels{ gather4(source.pixels, makeIndices4(x, y, source.stride)) };
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i*>(destination + i),
+					_mm_and_si128(pixels, inside)
+				);
+				u = _mm_add_epi32(u, stepU4);
+				v = _mm_add_epi32(v, stepV4);
+			}
+			sampleNearestScalar(destination + i, count - i, source, advanceSpan(span, i));
+		}
+
+		void sampleBilinearSse2(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			if (isEmpty(source)) {
+				fillScalar(destination, count, 0);
+				return;
+			}
+			const __m128i stepU4{ _mm_set1_epi32(span.stepU * 4) };
+			const __m128i stepV4{ _mm_set1_epi32(span.stepV * 4) };
+			__m128i u{ makeLanePositions4(span.u, span.stepU) };
+			__m128i v{ makeLanePositions4(span.v, span.stepV) };
+			const __m128i half{ _mm_set1_epi32(fixedOne / 2) };
+			const __m128i one{ _mm_set1_epi32(1) };
+			const __m128i amountMask{ _mm_set1_epi32(0xFF) };
+			const __m128i left{ _mm_set1_epi32(source.left) };
+			const __m128i right{ _mm_set1_epi32(source.right - 1) };
+			const __m128i top{ _mm_set1_epi32(source.top) };
+			const __m128i bottom{ _mm_set1_epi32(source.bottom - 1) };
+
+			std::size_t i{ 0 };
+			for (; i + 4 <= count; i += 4) {
+				const __m128i inside{ insideMask4(source, u, v) };
+				const __m128i sampleX{ _mm_sub_epi32(u, half) };
+				const __m128i sampleY{ _mm_sub_epi32(v, half) };
+				const __m128i texelX{ _mm_srai_epi32(sampleX, 16) };
+				const __m128i texelY{ _mm_srai_epi32(sampleY, 16) };
+				const __m128i x0{ clamp4(texelX, left, right) };
+				const __m128i x1{ clamp4(_mm_add_epi32(texelX, one), left, right) };
+				const __m128i y0{ clamp4(texelY, top, bottom) };
+				const __m128i y1{ clamp4(_mm_add_epi32(texelY, one), top, bottom) };
+				const __m128i amountX{ _mm_and_si128(_mm_srai_epi32(sampleX, 8), amountMask) };
+				const __m128i amountY{ _mm_and_si128(_mm_srai_epi32(sampleY, 8), amountMask) };
+
+				const __m128i top0{ gather4(source.pixels, makeIndices4(x0, y0, source.stride)) };
+				const __m128i top1{ gather4(source.pixels, makeIndices4(x1, y0, source.stride)) };
+				const __m128i bottom0{ gather4(source.pixels, makeIndices4(x0, y1, source.stride)) };
+				const __m128i bottom1{ gather4(source.pixels, makeIndices4(x1, y1, source.stride)) };
+				const __m128i pixels{ lerp4(
+					lerp4(top0, top1, amountX),
+					lerp4(bottom0, bottom1, amountX),
+					amountY
+				) };
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i*>(destination + i),
+					_mm_and_si128(pixels, inside)
+				);
+				u = _mm_add_epi32(u, stepU4);
+				v = _mm_add_epi32(v, stepV4);
+			}
+			sampleBilinearScalar(destination + i, count - i, source, advanceSpan(span, i));
+		}
+
+		constexpr Kernels sse2Kernels{
+			InstructionSet::sse2,
+			fillSse2,
+			modulateSse2,
+			blendSse2,
+			sampleNearestSse2,
+			sampleBilinearSse2
+		};
+
+		//avx2, 8 pixels at a time
+		//unpacking works within each 128 bit half, so the widened halves hold
+		//pixels 0, 1, 4, 5 and 2, 3, 6, 7, and packing puts them back in order
+
+		WASP_TARGET_AVX2 __m256i modulate16Avx2(__m256i channels, __m256i amounts) {
+			return _mm256_srli_epi16(_mm256_mullo_epi16(channels, amounts), 8);
+		}
+
+		WASP_TARGET_AVX2 __m256i lerp16Avx2(__m256i a, __m256i b, __m256i amounts) {
+			const __m256i inverse{ _mm256_sub_epi16(_mm256_set1_epi16(256), amounts) };
+			return _mm256_srli_epi16(
+				_mm256_add_epi16(
+					_mm256_mullo_epi16(a, inverse),
+					_mm256_mullo_epi16(b, amounts)
+				),
+				8
+			);
+		}
+
+		WASP_TARGET_AVX2 __m256i blend16Avx2(__m256i destination, __m256i source) {
+			const __m256i alpha{
+				_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(source, 0xFF), 0xFF)
+			};
+			const __m256i inverse{ _mm256_sub_epi16(
+				_mm256_set1_epi16(256),
+				_mm256_add_epi16(alpha, _mm256_srli_epi16(alpha, 7))
+			) };
+			return _mm256_add_epi16(source, modulate16Avx2(destination, inverse));
+		}
+
+		WASP_TARGET_AVX2 __m256i lerp8(__m256i a, __m256i b, __m256i amounts) {
+			const __m256i zero{ _mm256_setzero_si256() };
+			const __m256i doubled{ _mm256_or_si256(amounts, _mm256_slli_epi32(amounts, 16)) };
+			const __m256i low{ lerp16Avx2(
+				_mm256_unpacklo_epi8(a, zero),
+				_mm256_unpacklo_epi8(b, zero),
+				_mm256_unpacklo_epi32(doubled, doubled)
+			) };
+			const __m256i high{ lerp16Avx2(
+				_mm256_unpackhi_epi8(a, zero),
+				_mm256_unpackhi_epi8(b, zero),
+				_mm256_unpackhi_epi32(doubled, doubled)
+			) };
+			return _mm256_packus_epi16(low, high);
+		}
+
+		WASP_TARGET_AVX2 __m256i insideMask8(const SourceImage& source, __m256i u, __m256i v) {
+			const __m256i insideU{ _mm256_and_si256(
+				_mm256_cmpgt_epi32(u, _mm256_set1_epi32(source.left * fixedOne - 1)),
+				_mm256_cmpgt_epi32(_mm256_set1_epi32(source.right * fixedOne), u)
+			) };
+			const __m256i insideV{ _mm256_and_si256(
+				_mm256_cmpgt_epi32(v, _mm256_set1_epi32(source.top * fixedOne - 1)),
+				_mm256_cmpgt_epi32(_mm256_set1_epi32(source.bottom * fixedOne), v)
+			) };
+			return _mm256_and_si256(insideU, insideV);
+		}
+
+		WASP_TARGET_AVX2 __m256i makeLanePositions(int32_t start, int32_t step) {
+			return _mm256_add_epi32(
+				_mm256_set1_epi32(start),
+				_mm256_mullo_epi32(_mm256_set1_epi32(step), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))
+			);
+		}
+
+		WASP_TARGET_AVX2 __m256i gather8(
+			const SourceImage& source,
+			__m256i x,
+			__m256i y
+		) {
+			const __m256i indices{ _mm256_add_epi32(
+				x,
+				_mm256_mullo_epi32(y, _mm256_set1_epi32(source.stride))
+			) };
+			return _mm256_i32gather_epi32(
+				reinterpret_cast<const int*>(source.pixels),
+				indices,
+				4
+			);
+		}
+
+		WASP_TARGET_AVX2 void fillAvx2(uint32_t* destination, std::size_t count, uint32_t color) {
+			const __m256i colors{ _mm256_set1_epi32(static_cast<int32_t>(color)) };
+			std::size_t i{ 0 };
+			for (; i + 8 <= count; i += 8) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), colors);
+			}
+			fillScalar(destination + i, count - i, color);
+		}
+
+		WASP_TARGET_AVX2 void modulateAvx2(
+			uint32_t* destination,
+			const uint32_t* source,
+			std::size_t count,
+			uint32_t amount
+		) {
+			const __m256i zero{ _mm256_setzero_si256() };
+			const __m256i amounts{ _mm256_set1_epi16(static_cast<int16_t>(amount)) };
+			std::size_t i{ 0 };
+			for (; i + 8 <= count; i += 8) {
+				const __m256i pixels{
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i))
+				};
+				const __m256i low{ modulate16Avx2(_mm256_unpacklo_epi8(pixels, zero), amounts) };
+				const __m256i high{ modulate16Avx2(_mm256_unpackhi_epi8(pixels, zero), amounts) };
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*>(destination + i),
+					_mm256_packus_epi16(low, high)
+				);
+			}
+			modulateScalar(destination + i, source + i, count - i, amount);
+		}
+
+		WASP_TARGET_AVX2 void blendAvx2(
+			uint32_t* destination,
+			const uint32_t* source,
+			std::size_t count
+		) {
+			const __m256i zero{ _mm256_setzero_si256() };
+			std::size_t i{ 0 };
+			for (; i + 8 <= count; i += 8) {
+				const __m256i sourcePixels{
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i))
+				};
+				const __m256i destinationPixels{
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i))
+				};
+				const __m256i low{ blend16Avx2(
+					_mm256_unpacklo_epi8(destinationPixels, zero),
+					_mm256_unpacklo_epi8(sourcePixels, zero)
+				) };
+				const __m256i high{ blend16Avx2(
+					_mm256_unpackhi_epi8(destinationPixels, zero),
+					_mm256_unpackhi_epi8(sourcePixels, zero)
+				) };
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*>(destination + i),
+					_mm256_packus_epi16(low, high)
+				);
+			}
+			blendScalar(destination + i, source + i, count - i);
+		}
+
+		WASP_TARGET_AVX2 void sampleNearestAvx2(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			if (isEmpty(source)) {
+				fillScalar(destination, count, 0);
+				return;
+			}
+			__m256i u{ makeLanePositions(span.u, span.stepU) };
+			__m256i v{ makeLanePositions(span.v, span.stepV) };
+			const __m256i stepU8{ _mm256_set1_epi32(span.stepU * 8) };
+			const __m256i stepV8{ _mm256_set1_epi32(span.stepV * 8) };
+			const __m256i left{ _mm256_set1_epi32(source.left) };
+			const __m256i right{ _mm256_set1_epi32(source.right - 1) };
+			const __m256i top{ _mm256_set1_epi32(source.top) };
+			const __m256i bottom{ _mm256_set1_epi32(source.bottom - 1) };
+
+			std::size_t i{ 0 };
+			for (; i + 8 <= count; i += 8) {
+				const __m256i inside{ insideMask8(source, u, v) };
+				const __m256i x{ _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(u, 16), left), right) };
+				const __m256i y{ _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(v, 16), top), bottom) };
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*>(destination + i),
+					_mm256_and_si256(gather8(source, x, y), inside)
+				);
+				u = _mm256_add_epi32(u, stepU8);
+				v = _mm256_add_epi32(v, stepV8);
+			}
+			sampleNearestScalar(destination + i, count - i, source, advanceSpan(span, i));
+		}
+
+		WASP_TARGET_AVX2 void sampleBilinearAvx2(
+			uint32_t* destination,
+			std::size_t count,
+			const SourceImage& source,
+			const AffineSpan& span
+		) {
+			if (isEmpty(source)) {
+				fillScalar(destination, count, 0);
+				return;
+			}
+			__m256i u{ makeLanePositions(span.u, span.stepU) };
+			__m256i v{ makeLanePositions(span.v, span.stepV) };
+			const __m256i stepU8{ _mm256_set1_epi32(span.stepU * 8) };
+			const __m256i stepV8{ _mm256_set1_epi32(span.stepV * 8) };
+			const __m256i half{ _mm256_set1_epi32(fixedOne / 2) };
+			const __m256i one{ _mm256_set1_epi32(1) };
+			const __m256i amountMask{ _mm256_set1_epi32(0xFF) };
+			const __m256i left{ _mm256_set1_epi32(source.left) };
+			const __m256i right{ _mm256_set1_epi32(source.right - 1) };
+			const __m256i top{ _mm256_set1_epi32(source.top) };
+			const __m256i bottom{ _mm256_set1_epi32(source.bottom - 1) };
+
+			std::size_t i{ 0 };
+			for (; i + 8 <= count; i += 8) {
+				const __m256i inside{ insideMask8(source, u, v) };
+				const __m256i sampleX{ _mm256_sub_epi32(u, half) };
+				const __m256i sampleY{ _mm256_sub_epi32(v, half) };
+				const __m256i texelX{ _mm256_srai_epi32(sampleX, 16) };
+				const __m256i texelY{ _mm256_srai_epi32(sampleY, 16) };
+				const __m256i x0{ _mm256_min_epi32(_mm256_max_epi32(texelX, left), right) };
+				const __m256i x1{
+					_mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(texelX, one), left), right)
+				};
+				const __m256i y0{ _mm256_min_epi32(_mm256_max_epi32(texelY, top), bottom) };
+				const __m256i y1{
+					_mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(texelY, one), top), bottom)
+				};
+				const __m256i amountX{ _mm256_and_si256(_mm256_srai_epi32(sampleX, 8), amountMask) };
+				const __m256i amountY{ _mm256_and_si256(_mm256_srai_epi32(sampleY, 8), amountMask) };
+
+				const __m256i pixels{ lerp8(
+					lerp8(gather8(source, x0, y0), gather8(source, x1, y0), amountX),
+					lerp8(gather8(source, x0, y1), gather8(source, x1, y1), amountX),
+					amountY
+				) };
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*>(destination + i),
+					_mm256_and_si256(pixels, inside)
+				);
+				u = _mm256_add_epi32(u, stepU8);
+				v = _mm256_add_epi32(v, stepV8);
+			}
+			sampleBilinearScalar(destination + i, count - i, source, advanceSpan(span, i));
+		}
+
+		constexpr Kernels avx2Kernels{
+			InstructionSet::avx2,
+			fillAvx2,
+			modulateAvx2,
+			blendAvx2,
+			sampleNearestAvx2,
+			sampleBilinearAvx2
+		};
+
+		bool isAvx2Supported() {
+			#ifdef _MSC_VER
+			int registers[4]{};	//eax, ebx, ecx, edx
+			__cpuid(registers, 0);
+			if (registers[0] < 7) {
+				return false;
+			}
+			__cpuid(registers, 1);
+			constexpr int osSavesRegistersBit{ 1 << 27 };
+			constexpr int avxBit{ 1 << 28 };
+			if ((registers[2] & osSavesRegistersBit) == 0 || (registers[2] & avxBit) == 0) {
+				return false;
+			}
+			//the os has to save the ymm registers on context switches
+			constexpr unsigned long long xmmAndYmmState{ 0b110 };
+			if ((_xgetbv(0) & xmmAndYmmState) != xmmAndYmmState) {
+				return false;
+			}
+			__cpuidex(registers, 7, 0);
+			constexpr int avx2Bit{ 1 << 5 };	//in ebx
+			return (registers[1] & avx2Bit) != 0;
+			#else
+			//also checks the os saves the ymm registers
+			return __builtin_cpu_supports("avx2");
+			#endif
+		}
+
+		#endif
+	}
+
+	bool isSupported(InstructionSet instructionSet) {
+		switch (instructionSet) {
+			case InstructionSet::scalar:
+				return true;
+			#ifdef WASP_PIXEL_X86
+			case InstructionSet::sse2:
+				return true;
+			case InstructionSet::avx2: {
+				static const bool avx2Supported{ isAvx2Supported() };
+				return avx2Supported;
+			}
+			#endif
+			default:
+				return false;
+		}
+	}
+
+	InstructionSet getBestInstructionSet() {
+		if (isSupported(InstructionSet::avx2)) {
+			return InstructionSet::avx2;
+		}
+		if (isSupported(InstructionSet::sse2)) {
+			return InstructionSet::sse2;
+		}
+		return InstructionSet::scalar;
+	}
+
+	const Kernels& getKernels(InstructionSet instructionSet) {
+		if (!isSupported(instructionSet)) {
+			throw std::runtime_error{ "Error pixel instruction set not supported" };
+		}
+		switch (instructionSet) {
+			#ifdef WASP_PIXEL_X86
+			case InstructionSet::sse2:
+				return sse2Kernels;
+			case InstructionSet::avx2:
+				return avx2Kernels;
+			#endif
+			default:
+				return scalarKernels;
+		}
+	}
+
+	const Kernels& getKernels() {
+		static const Kernels& bestKernels{ getKernels(getBestInstructionSet()) };
+		return bestKernels;
+	}
+
+	const char* getName(InstructionSet instructionSet) {
+		switch (instructionSet) {
+			case InstructionSet::scalar:
+				return "scalar";
+			case InstructionSet::sse2:
+				return "sse2";
+			case InstructionSet::avx2:
+				return "avx2";
+		}
+		return "unknown";
+	}
+}
\ No newline at end of file
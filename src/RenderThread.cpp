@@ -0,0 +1,127 @@
+#include "RenderThread.h"
+
+#include <chrono>
+
+namespace wasp::window {
+
+	RenderThread::~RenderThread() {
+		stop();
+	}
+
+	void RenderThread::start() {
+		if (thread.joinable()) {
+			return;
+		}
+		stopRequested = false;
+		thread = std::thread{ [&] { renderLoop(); } };
+	}
+
+	void RenderThread::stop() {
+		{
+			std::lock_guard<std::mutex> lock{ wakeMutex };
+			stopRequested = true;
+		}
+		wakeCondition.notify_one();
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+
+	void RenderThread::submit() {
+		drawLists.publish();
+		{
+			std::lock_guard<std::mutex> lock{ wakeMutex };
+			frameSubmitted = true;
+		}
+		wakeCondition.notify_one();
+	}
+
+	void RenderThread::requestPresent() {
+		{
+			std::lock_guard<std::mutex> lock{ wakeMutex };
+			presentRequested = true;
+		}
+		wakeCondition.notify_one();
+	}
+
+	void RenderThread::requestResize() {
+		{
+			std::lock_guard<std::mutex> lock{ wakeMutex };
+			resizeRequested = true;
+		}
+		wakeCondition.notify_one();
+	}
+
+	void RenderThread::renderLoop() {
+		std::chrono::steady_clock::time_point lastFrame{
+			std::chrono::steady_clock::now()
+		};
+
+		std::unique_lock<std::mutex> lock{ wakeMutex };
+		while (true) {
+			wakeCondition.wait(lock, [&] {
+				return frameSubmitted
+					|| presentRequested
+					|| resizeRequested
+					|| stopRequested;
+			});
+			if (stopRequested) {
+				return;
+			}
+			const bool resize{ resizeRequested };
+			const bool present{ presentRequested || resizeRequested };
+			frameSubmitted = false;
+			presentRequested = false;
+			resizeRequested = false;
+			lock.unlock();
+
+			if (resize) {
+				windowPainter.resize(windowHandle);
+			}
+			if (betweenFramesCallback) {
+				betweenFramesCallback();
+			}
+
+			if (drawLists.acquire()) {
+				renderFrame(drawLists.getReadBuffer());
+
+				const std::chrono::steady_clock::time_point thisFrame{
+					std::chrono::steady_clock::now()
+				};
+				const double frameSeconds{
+					std::chrono::duration<double>{ thisFrame - lastFrame }.count()
+				};
+				lastFrame = thisFrame;
+				averageFrameSeconds.store(
+					(getAverageFrameSeconds() * smoothing) 
+						+ (frameSeconds * (1.0 - smoothing)),
+					std::memory_order_relaxed
+				);
+				framesRendered.fetch_add(1, std::memory_order_relaxed);
+			}
+			//no new frame, show the last one again
+			else if (present) {
+				windowPainter.present(windowHandle);
+			}
+
+			lock.lock();
+		}
+	}
+
+	void RenderThread::renderFrame(const graphics::DrawList& drawList) {
+		windowPainter.beginDraw();
+		drawList.replay(windowPainter, windowPainter);
+		windowPainter.endDraw();
+		//blocks on vsync
+		const debug::HitchDetector::timePointType presentBegin{
+			debug::HitchDetector::clockType::now()
+		};
+		windowPainter.present(windowHandle);
+		if (hitchDetector) {
+			hitchDetector->recordPresent(
+				presentBegin, 
+				debug::HitchDetector::clockType::now()
+			);
+		}
+	}
+}
\ No newline at end of file
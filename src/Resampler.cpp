@@ -0,0 +1,236 @@
+#include "Resampler.h"
+
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define WASP_RESAMPLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace wasp::sound {
+
+	static constexpr double pi{ 3.14159265358979323846 };
+
+	//modified bessel function of the first kind, order 0
+	static double besselI0(double x) {
+		double sum{ 1.0 };
+		double term{ 1.0 };
+		const double halfXSquared{ (x / 2.0) * (x / 2.0) };
+		for (int k{ 1 }; k < 50 && term > sum * 1e-12; ++k) {
+			term *= halfXSquared / (static_cast<double>(k) * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	static double kaiserWindow(double position, double length, double beta) {
+		//position in [0, length]
+		const double ratio{ (2.0 * position / length) - 1.0 };
+		return besselI0(beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio)))
+			/ besselI0(beta);
+	}
+
+	static double sinc(double x) {
+		if (x == 0.0) {
+			return 1.0;
+		}
+		return std::sin(pi * x) / (pi * x);
+	}
+
+	static float dotProduct(const float* coefficients, const float* samples, int count) {
+		#ifdef WASP_RESAMPLER_SSE
+		__m128 sum0{ _mm_setzero_ps() };
+		__m128 sum1{ _mm_setzero_ps() };
+		int i{ 0 };
+		for (; i + 8 <= count; i += 8) {
+			sum0 = _mm_add_ps(
+				sum0, 
+				_mm_mul_ps(_mm_loadu_ps(coefficients + i), _mm_loadu_ps(samples + i))
+			);
+			sum1 = _mm_add_ps(
+				sum1,
+				_mm_mul_ps(_mm_loadu_ps(coefficients + i + 4), _mm_loadu_ps(samples + i + 4))
+			);
+		}
+		for (; i + 4 <= count; i += 4) {
+			sum0 = _mm_add_ps(
+				sum0,
+				_mm_mul_ps(_mm_loadu_ps(coefficients + i), _mm_loadu_ps(samples + i))
+			);
+		}
+		sum0 = _mm_add_ps(sum0, sum1);
+		//horizontal add
+		__m128 shuffled{ _mm_movehl_ps(sum0, sum0) };
+		sum0 = _mm_add_ps(sum0, shuffled);
+		shuffled = _mm_shuffle_ps(sum0, sum0, _MM_SHUFFLE(1, 1, 1, 1));
+		float toRet{ _mm_cvtss_f32(_mm_add_ss(sum0, shuffled)) };
+		for (; i < count; ++i) {
+			toRet += coefficients[i] * samples[i];
+		}
+		return toRet;
+		#else
+		float toRet{ 0.0f };
+		for (int i{ 0 }; i < count; ++i) {
+			toRet += coefficients[i] * samples[i];
+		}
+		return toRet;
+		#endif
+	}
+
+	Resampler::Resampler(
+		uint32_t inputRate,
+		uint32_t outputRate,
+		int channels,
+		int tapsPerPhase
+	)
+		: channels{ channels }
+		, tapsPerPhase{ tapsPerPhase }
+		, channelInputs(channels > 0 ? channels : 0) {
+
+		if (inputRate == 0 || outputRate == 0) {
+			throw std::invalid_argument{ "Error resampler rate 0" };
+		}
+		if (channels <= 0) {
+			throw std::invalid_argument{ "Error resampler needs at least 1 channel" };
+		}
+		if (tapsPerPhase <= 0) {
+			throw std::invalid_argument{ "Error resampler needs at least 1 tap" };
+		}
+
+		const uint32_t divisor{ std::gcd(inputRate, outputRate) };
+		upFactor = outputRate / divisor;
+		downFactor = inputRate / divisor;
+
+		//when downsampling the cutoff drops with the output rate, so the window
+		//has to cover proportionally more input samples for the same quality
+		if (downFactor > upFactor) {
+			const uint64_t scaledTaps{
+				(static_cast<uint64_t>(tapsPerPhase) * downFactor + upFactor - 1) / upFactor
+			};
+			this->tapsPerPhase = static_cast<int>((scaledTaps + 3) & ~uint64_t{ 3 });
+		}
+
+		buildFilterBank();
+		reset();
+	}
+
+	void Resampler::buildFilterBank() {
+		const std::size_t prototypeLength{
+			static_cast<std::size_t>(upFactor) * tapsPerPhase
+		};
+		//cutoff in cycles per sample of the upsampled signal
+		const double cutoff{
+			0.5 * passband / std::max(upFactor, downFactor)
+		};
+		const double center{ (prototypeLength - 1) / 2.0 };
+
+		std::vector<double> prototype(prototypeLength);
+		for (std::size_t n{ 0 }; n < prototypeLength; ++n) {
+			prototype[n] = 2.0 * cutoff * sinc(2.0 * cutoff * (n - center))
+				* kaiserWindow(
+					static_cast<double>(n), 
+					static_cast<double>(prototypeLength - 1), 
+					kaiserBeta
+				);
+		}
+
+		//phase p uses every upFactor'th coefficient starting at p
+		filterBank.resize(prototypeLength);
+		for (uint32_t p{ 0 }; p < upFactor; ++p) {
+			double phaseSum{ 0.0 };
+			for (int k{ 0 }; k < tapsPerPhase; ++k) {
+				phaseSum += prototype[p + static_cast<std::size_t>(k) * upFactor];
+			}
+			//normalize each phase for unity gain at DC
+			float* row{ &filterBank[static_cast<std::size_t>(p) * tapsPerPhase] };
+			for (int k{ 0 }; k < tapsPerPhase; ++k) {
+				row[tapsPerPhase - 1 - k] = static_cast<float>(
+					prototype[p + static_cast<std::size_t>(k) * upFactor] / phaseSum
+				);
+			}
+		}
+	}
+
+	void Resampler::reset() {
+		//prime with silence so the first output sample has a full window
+		for (auto& channelInput : channelInputs) {
+			channelInput.assign(tapsPerPhase - 1, 0.0f);
+		}
+		inputPosition = 0;
+		phase = 0;
+	}
+
+	void Resampler::push(const float* interleavedInput, std::size_t frames) {
+		compactInputs();
+		for (int channel{ 0 }; channel < channels; ++channel) {
+			std::vector<float>& channelInput{ channelInputs[channel] };
+			const std::size_t oldSize{ channelInput.size() };
+			channelInput.resize(oldSize + frames);
+			float* destination{ channelInput.data() + oldSize };
+			const float* source{ interleavedInput + channel };
+			for (std::size_t frame{ 0 }; frame < frames; ++frame) {
+				destination[frame] = *source;
+				source += channels;
+			}
+		}
+	}
+
+	std::size_t Resampler::getAvailableFrames() const {
+		const std::size_t bufferedFrames{ channelInputs[0].size() };
+		if (bufferedFrames < inputPosition + tapsPerPhase) {
+			return 0;
+		}
+		//number of steps before the window runs past the buffered input
+		const uint64_t stepsRemaining{
+			(static_cast<uint64_t>(bufferedFrames - inputPosition - tapsPerPhase + 1)
+				* upFactor - phase + downFactor - 1) / downFactor
+		};
+		return static_cast<std::size_t>(stepsRemaining);
+	}
+
+	std::size_t Resampler::pull(float* interleavedOutput, std::size_t maxFrames) {
+		const std::size_t bufferedFrames{ channelInputs[0].size() };
+		std::size_t framesWritten{ 0 };
+		while (framesWritten < maxFrames
+			&& inputPosition + tapsPerPhase <= bufferedFrames
+		) {
+			const float* row{ &filterBank[static_cast<std::size_t>(phase) * tapsPerPhase] };
+			for (int channel{ 0 }; channel < channels; ++channel) {
+				*interleavedOutput++ = dotProduct(
+					row, 
+					channelInputs[channel].data() + inputPosition, 
+					tapsPerPhase
+				);
+			}
+			advance();
+			++framesWritten;
+		}
+		return framesWritten;
+	}
+
+	inline void Resampler::advance() {
+		phase += downFactor;
+		inputPosition += phase / upFactor;
+		phase %= upFactor;
+	}
+
+	void Resampler::compactInputs() {
+		if (inputPosition < compactThreshold) {
+			return;
+		}
+		//downsampling can step the window past the end of what has been pushed
+		const std::size_t consumedFrames{
+			std::min(inputPosition, channelInputs[0].size())
+		};
+		for (auto& channelInput : channelInputs) {
+			channelInput.erase(
+				channelInput.begin(), 
+				channelInput.begin() + consumedFrames
+			);
+		}
+		inputPosition -= consumedFrames;
+	}
+}
\ No newline at end of file
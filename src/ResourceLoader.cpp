@@ -32,6 +32,7 @@ namespace wasp::resource {
 		const std::wstring& extension{ 
 			file::getFileExtension(fileOrigin.fileName)
 		};
+		const WriteBatch writeBatch{ storagePointers };
 		return fileExtensionMap.at(extension)->loadFromFile(fileOrigin, *this);
 	}
 
@@ -39,6 +40,7 @@ namespace wasp::resource {
 		const ManifestOrigin& manifestOrigin
 	) const {
 		const std::wstring& prefix{ manifestOrigin.manifestArguments[0] };
+		const WriteBatch writeBatch{ storagePointers };
 		return manifestPrefixMap.at(prefix)->loadFromManifest(manifestOrigin, *this);
 	}
 }
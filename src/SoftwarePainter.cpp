@@ -0,0 +1,124 @@
+#include "SoftwarePainter.h"
+
+#include <stdexcept>
+
+#include "Config.h"
+#include "BitmapConstructor.h"
+
+namespace wasp::graphics {
+
+	SoftwarePainter::SoftwarePainter()
+		: rasterizer{ config::graphicsWidth, config::graphicsHeight } {
+	}
+
+	void SoftwarePainter::addBitmap(
+		const CComPtr<ID2D1Bitmap>& d2dBitmap,
+		const CComPtr<IWICFormatConverter>& wicBitmap
+	) {
+		bitmaps[static_cast<ID2D1Bitmap*>(d2dBitmap)] 
+			= BitmapConstructor::copyWicPixels(wicBitmap);
+	}
+
+	void SoftwarePainter::addBitmap(
+		const CComPtr<ID2D1Bitmap>& d2dBitmap,
+		SoftwareBitmap softwareBitmap
+	) {
+		bitmaps[static_cast<ID2D1Bitmap*>(d2dBitmap)] = std::move(softwareBitmap);
+	}
+
+	void SoftwarePainter::beginDraw() {
+		rasterizer.clear(SoftwareRasterizer::makeOpaqueColor(config::fillColor));
+	}
+
+	void SoftwarePainter::drawBitmap(
+		const geometry::Point2 center,
+		const BitmapDrawInstruction& bitmapDrawInstruction
+	) {
+		const SoftwareBitmap& bitmap{ getSoftwareBitmap(bitmapDrawInstruction) };
+		drawSubBitmap(
+			center,
+			bitmapDrawInstruction,
+			{ 
+				0.0f, 
+				0.0f, 
+				static_cast<float>(bitmap.width), 
+				static_cast<float>(bitmap.height) 
+			}
+		);
+	}
+
+	void SoftwarePainter::drawSubBitmap(
+		const geometry::Point2 center,
+		const BitmapDrawInstruction& bitmapDrawInstruction,
+		const geometry::Rectangle& sourceRectangle
+	) {
+		rasterizer.drawBitmap(
+			getSoftwareBitmap(bitmapDrawInstruction),
+			center,
+			sourceRectangle,
+			bitmapDrawInstruction.getRotationDegrees(),
+			bitmapDrawInstruction.getScale(),
+			bitmapDrawInstruction.getOpacity()
+		);
+	}
+
+	void SoftwarePainter::drawBitmapBatch(
+		const CComPtr<ID2D1Bitmap>& bitmap,
+		utility::Span<const SpriteInstance> instances
+	) {
+		//one lookup for the whole batch
+		const SoftwareBitmap& softwareBitmap{ 
+			getSoftwareBitmap(static_cast<ID2D1Bitmap*>(bitmap)) 
+		};
+		for (const SpriteInstance& instance : instances) {
+			rasterizer.drawBitmap(
+				softwareBitmap,
+				instance.center,
+				instance.getPixelSourceRectangle(),
+				instance.rotationDegrees,
+				instance.scale,
+				instance.opacity
+			);
+		}
+	}
+
+	void SoftwarePainter::drawText(
+		const geometry::Point2 pos,
+		const std::wstring& text,
+		const std::pair<float, float> bounds
+	) {
+		rasterizer.drawText(
+			pos, 
+			text, 
+			bounds, 
+			SoftwareRasterizer::makeOpaqueColor(config::textColor)
+		);
+	}
+
+	void SoftwarePainter::endDraw() {
+		if (!frameDumpPrefix.empty()) {
+			rasterizer.writeBitmapFile(
+				frameDumpPrefix + std::to_string(frameIndex) + ".bmp"
+			);
+		}
+		++frameIndex;
+	}
+
+	const SoftwareBitmap& SoftwarePainter::getSoftwareBitmap(
+		const BitmapDrawInstruction& bitmapDrawInstruction
+	) const {
+		return getSoftwareBitmap(
+			static_cast<ID2D1Bitmap*>(bitmapDrawInstruction.getBitmap())
+		);
+	}
+
+	const SoftwareBitmap& SoftwarePainter::getSoftwareBitmap(
+		ID2D1Bitmap* d2dBitmap
+	) const {
+		auto found{ bitmaps.find(d2dBitmap) };
+		if (found == bitmaps.end()) {
+			throw std::runtime_error{ "Error bitmap not added to software painter" };
+		}
+		return std::get<1>(*found);
+	}
+}
\ No newline at end of file
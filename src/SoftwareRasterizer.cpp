@@ -0,0 +1,316 @@
+#include "SoftwareRasterizer.h"
+
+#include "PixelKernels.h"
+
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+namespace wasp::graphics {
+
+	//columns of the classic 5x7 font for ' ' to '~', low bit at the top,
+	//bit 7 is the descender row
+	static constexpr uint8_t font[][5]{
+		{ 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 },
+		{ 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 },
+		{ 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+		{ 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 },
+		{ 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 },
+		{ 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+		{ 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 },
+		{ 0x00, 0x00, 0x60, 0x60, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+		{ 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+		{ 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 },
+		{ 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 },
+		{ 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+		{ 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E },
+		{ 0x00, 0x00, 0x14, 0x00, 0x00 }, { 0x00, 0x40, 0x34, 0x00, 0x00 },
+		{ 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+		{ 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 },
+		{ 0x3E, 0x41, 0x5D, 0x59, 0x4E }, { 0x7C, 0x12, 0x11, 0x12, 0x7C },
+		{ 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+		{ 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 },
+		{ 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x41, 0x51, 0x73 },
+		{ 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+		{ 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 },
+		{ 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x1C, 0x02, 0x7F },
+		{ 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+		{ 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E },
+		{ 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x26, 0x49, 0x49, 0x49, 0x32 },
+		{ 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+		{ 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F },
+		{ 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x03, 0x04, 0x78, 0x04, 0x03 },
+		{ 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 },
+		{ 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F },
+		{ 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 },
+		{ 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+		{ 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 },
+		{ 0x38, 0x44, 0x44, 0x28, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 },
+		{ 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },
+		{ 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 },
+		{ 0x20, 0x40, 0x40, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 },
+		{ 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 },
+		{ 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 },
+		{ 0xFC, 0x18, 0x24, 0x24, 0x18 }, { 0x18, 0x24, 0x24, 0x18, 0xFC },
+		{ 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+		{ 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C },
+		{ 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C },
+		{ 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C },
+		{ 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 },
+		{ 0x00, 0x00, 0x77, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 },
+		{ 0x02, 0x01, 0x02, 0x04, 0x02 }
+	};
+	static constexpr wchar_t firstGlyph{ L' ' };
+	static constexpr wchar_t lastGlyph{ L'~' };
+
+	static constexpr float pi{ 3.14159265358979f };
+
+	SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+		: width{ width }
+		, height{ height } {
+		if (width <= 0 || height <= 0) {
+			throw std::invalid_argument{ "Error software framebuffer size <= 0" };
+		}
+		pixels.resize(static_cast<std::size_t>(width) * height);
+		rowBuffer.resize(width);
+	}
+
+	void SoftwareRasterizer::clear(uint32_t color) {
+		pixel::fill(pixels.data(), pixels.size(), color);
+	}
+
+	void SoftwareRasterizer::drawBitmap(
+		const SoftwareBitmap& bitmap,
+		const geometry::Point2 center,
+		const geometry::Rectangle& sourceRectangle,
+		float rotationDegrees,
+		float scale,
+		float opacity
+	) {
+		if (opacity <= 0.0f || scale <= 0.0f
+			|| sourceRectangle.width <= 0.0f || sourceRectangle.height <= 0.0f
+		) {
+			return;
+		}
+		const uint32_t opacityAmount{
+			static_cast<uint32_t>(std::min(opacity, 1.0f) * 256.0f + 0.5f)
+		};
+
+		//texels that can be sampled, the source rectangle inside the bitmap
+		const float sourceLeft{ std::max(sourceRectangle.x, 0.0f) };
+		const float sourceTop{ std::max(sourceRectangle.y, 0.0f) };
+		const float sourceRight{
+			std::min(sourceRectangle.x + sourceRectangle.width, static_cast<float>(bitmap.width))
+		};
+		const float sourceBottom{
+			std::min(sourceRectangle.y + sourceRectangle.height, static_cast<float>(bitmap.height))
+		};
+		if (sourceRight <= sourceLeft || sourceBottom <= sourceTop) {
+			return;
+		}
+
+		const float halfWidth{ sourceRectangle.width * scale / 2.0f };
+		const float halfHeight{ sourceRectangle.height * scale / 2.0f };
+
+		//pixel for pixel copies skip the filtering, the common sprite case
+		const float left{ center.x - halfWidth };
+		const float top{ center.y - halfHeight };
+		if (rotationDegrees == 0.0f && scale == 1.0f
+			&& left == std::floor(left) && top == std::floor(top)
+			&& sourceRectangle.x == std::floor(sourceRectangle.x)
+			&& sourceRectangle.y == std::floor(sourceRectangle.y)
+			&& sourceRectangle.width == std::floor(sourceRectangle.width)
+			&& sourceRectangle.height == std::floor(sourceRectangle.height)
+		) {
+			copyUnscaled(
+				bitmap,
+				static_cast<int>(left) + static_cast<int>(sourceLeft - sourceRectangle.x),
+				static_cast<int>(top) + static_cast<int>(sourceTop - sourceRectangle.y),
+				static_cast<int>(sourceLeft),
+				static_cast<int>(sourceTop),
+				static_cast<int>(sourceRight - sourceLeft),
+				static_cast<int>(sourceBottom - sourceTop),
+				opacityAmount
+			);
+			return;
+		}
+
+		//forward is screen = center + rotate(local * scale), clockwise on screen
+		const float radians{ rotationDegrees * pi / 180.0f };
+		const float cosine{ std::cos(radians) };
+		const float sine{ std::sin(radians) };
+
+		//screen bounds of the rotated corners
+		const float extentX{ std::abs(halfWidth * cosine) + std::abs(halfHeight * sine) };
+		const float extentY{ std::abs(halfWidth * sine) + std::abs(halfHeight * cosine) };
+		const int minX{ std::max(static_cast<int>(std::floor(center.x - extentX)), 0) };
+		const int maxX{ std::min(static_cast<int>(std::ceil(center.x + extentX)), width) };
+		const int minY{ std::max(static_cast<int>(std::floor(center.y - extentY)), 0) };
+		const int maxY{ std::min(static_cast<int>(std::ceil(center.y + extentY)), height) };
+		if (minX >= maxX || minY >= maxY) {
+			return;
+		}
+
+		//inverse mapping, source position changes by a constant step per pixel
+		const pixel::SourceImage sourceImage{
+			bitmap.pixels.data(),
+			bitmap.width,
+			static_cast<int>(sourceLeft),
+			static_cast<int>(sourceTop),
+			static_cast<int>(std::ceil(sourceRight)),
+			static_cast<int>(std::ceil(sourceBottom))
+		};
+		const float sourceCenterX{ sourceRectangle.x + sourceRectangle.width / 2.0f };
+		const float sourceCenterY{ sourceRectangle.y + sourceRectangle.height / 2.0f };
+		const std::size_t spanWidth{ static_cast<std::size_t>(maxX - minX) };
+
+		for (int y{ minY }; y < maxY; ++y) {
+			const float offsetX{ minX + 0.5f - center.x };
+			const float offsetY{ y + 0.5f - center.y };
+			const pixel::AffineSpan span{
+				pixel::toFixed(sourceCenterX + (offsetX * cosine + offsetY * sine) / scale),
+				pixel::toFixed(sourceCenterY + (-offsetX * sine + offsetY * cosine) / scale),
+				pixel::toFixed(cosine / scale),
+				pixel::toFixed(-sine / scale)
+			};
+			uint32_t* row{ pixels.data() + static_cast<std::size_t>(y) * width + minX };
+			pixel::sampleBilinear(rowBuffer.data(), spanWidth, sourceImage, span);
+			if (opacityAmount < 256) {
+				pixel::modulate(rowBuffer.data(), rowBuffer.data(), spanWidth, opacityAmount);
+			}
+			pixel::blend(row, rowBuffer.data(), spanWidth);
+		}
+	}
+
+	void SoftwareRasterizer::copyUnscaled(
+		const SoftwareBitmap& bitmap,
+		int left,
+		int top,
+		int sourceX,
+		int sourceY,
+		int copyWidth,
+		int copyHeight,
+		uint32_t opacity
+	) {
+		//clip to the framebuffer
+		if (left < 0) {
+			sourceX -= left;
+			copyWidth += left;
+			left = 0;
+		}
+		if (top < 0) {
+			sourceY -= top;
+			copyHeight += top;
+			top = 0;
+		}
+		copyWidth = std::min(copyWidth, width - left);
+		copyHeight = std::min(copyHeight, height - top);
+		if (copyWidth <= 0 || copyHeight <= 0) {
+			return;
+		}
+
+		for (int y{ 0 }; y < copyHeight; ++y) {
+			uint32_t* destination{
+				pixels.data() + static_cast<std::size_t>(top + y) * width + left
+			};
+			const uint32_t* source{
+				bitmap.pixels.data()
+					+ static_cast<std::size_t>(sourceY + y) * bitmap.width + sourceX
+			};
+			if (opacity >= 256) {
+				pixel::blend(destination, source, copyWidth);
+			}
+			else {
+				pixel::modulate(rowBuffer.data(), source, copyWidth, opacity);
+				pixel::blend(destination, rowBuffer.data(), copyWidth);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::drawText(
+		const geometry::Point2 pos,
+		const std::wstring& text,
+		const std::pair<float, float> bounds,
+		uint32_t color
+	) {
+		const int boundsLeft{ static_cast<int>(pos.x) };
+		const int boundsTop{ static_cast<int>(pos.y) };
+		const int boundsRight{ static_cast<int>(pos.x + bounds.first) };
+		const int boundsBottom{ static_cast<int>(pos.y + bounds.second) };
+
+		int glyphLeft{ boundsLeft };
+		int glyphTop{ boundsTop };
+		for (wchar_t character : text) {
+			if (character == L'\n' || glyphLeft + glyphWidth > boundsRight) {
+				glyphLeft = boundsLeft;
+				glyphTop += glyphHeight;
+				if (character == L'\n') {
+					continue;
+				}
+			}
+			if (glyphTop + glyphHeight > boundsBottom) {
+				return;
+			}
+			if (character < firstGlyph || character > lastGlyph) {
+				character = L'?';
+			}
+			const uint8_t* columns{ font[character - firstGlyph] };
+			for (int column{ 0 }; column < 5; ++column) {
+				const int x{ glyphLeft + column };
+				if (x < 0 || x >= width) {
+					continue;
+				}
+				for (int bit{ 0 }; bit < 8; ++bit) {
+					const int y{ glyphTop + bit };
+					if ((columns[column] >> bit & 1) && y >= 0 && y < height) {
+						uint32_t& pixel{ pixels[static_cast<std::size_t>(y) * width + x] };
+						pixel::blend(&pixel, &color, 1);
+					}
+				}
+			}
+			glyphLeft += glyphWidth;
+		}
+	}
+
+	static void writeLittleEndian(std::ofstream& outStream, uint32_t value, int byteCount) {
+		for (int i{ 0 }; i < byteCount; ++i) {
+			outStream.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+		}
+	}
+
+	void SoftwareRasterizer::writeBitmapFile(const std::string& fileName) const {
+		std::ofstream outStream{ fileName, std::ios::binary };
+		if (!outStream) {
+			throw std::runtime_error{ "Error opening frame dump file" };
+		}
+		constexpr uint32_t headerSize{ 14 + 40 };
+		const uint32_t imageSize{ static_cast<uint32_t>(pixels.size() * 4) };
+
+		//file header
+		outStream.put('B');
+		outStream.put('M');
+		writeLittleEndian(outStream, headerSize + imageSize, 4);
+		writeLittleEndian(outStream, 0, 4);
+		writeLittleEndian(outStream, headerSize, 4);
+		//info header, negative height for top down rows
+		writeLittleEndian(outStream, 40, 4);
+		writeLittleEndian(outStream, static_cast<uint32_t>(width), 4);
+		writeLittleEndian(outStream, static_cast<uint32_t>(-height), 4);
+		writeLittleEndian(outStream, 1, 2);		//planes
+		writeLittleEndian(outStream, 32, 2);	//bits per pixel
+		writeLittleEndian(outStream, 0, 4);		//uncompressed
+		writeLittleEndian(outStream, imageSize, 4);
+		writeLittleEndian(outStream, 2835, 4);	//72 dpi
+		writeLittleEndian(outStream, 2835, 4);
+		writeLittleEndian(outStream, 0, 4);
+		writeLittleEndian(outStream, 0, 4);
+
+		for (uint32_t pixel : pixels) {
+			writeLittleEndian(outStream, pixel, 4);
+		}
+		if (!outStream) {
+			throw std::runtime_error{ "Error writing frame dump file" };
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "SubsystemScheduler.h"
+
+#include <stdexcept>
+
+namespace wasp::game::gameloop {
+
+	std::size_t SubsystemScheduler::addSubsystem(
+		const std::string& name,
+		int ticksPerSecond,
+		double phase,
+		const tickFunctionType& tickFunction
+	) {
+		if (ticksPerSecond <= 0) {
+			throw std::invalid_argument{ "Error subsystem ticksPerSecond <= 0" };
+		}
+		if (phase < 0.0 || phase >= 1.0) {
+			throw std::out_of_range{ "Error subsystem phase out of range" };
+		}
+		if (!tickFunction) {
+			throw std::invalid_argument{ "Error subsystem has no tick function" };
+		}
+
+		Subsystem subsystem{};
+		subsystem.name = name;
+		subsystem.ticksPerSecond = ticksPerSecond;
+		subsystem.phaseOffset = nanosecondsType{
+			static_cast<int64_t>(phase * nanosecondsPerSecond / ticksPerSecond)
+		};
+		subsystem.tickFunction = tickFunction;
+		subsystem.nextDueTime = calcDueTime(subsystem);
+		subsystems.push_back(std::move(subsystem));
+		return subsystems.size() - 1;
+	}
+
+	uint64_t SubsystemScheduler::runUntil(nanosecondsType timelineLimit) {
+		uint64_t ticksRun{ 0 };
+		while (true) {
+			//few enough subsystems that a scan beats keeping a heap in order
+			Subsystem* next{ nullptr };
+			for (Subsystem& subsystem : subsystems) {
+				if (!next || subsystem.nextDueTime < next->nextDueTime) {
+					next = &subsystem;
+				}
+			}
+			if (!next || next->nextDueTime >= timelineLimit) {
+				return ticksRun;
+			}
+			next->tickFunction();
+			++next->scheduleIndex;
+			++next->tickCount;
+			next->nextDueTime = calcDueTime(*next);
+			++ticksRun;
+		}
+	}
+
+	void SubsystemScheduler::restart() {
+		for (Subsystem& subsystem : subsystems) {
+			subsystem.scheduleIndex = 0;
+			subsystem.nextDueTime = calcDueTime(subsystem);
+		}
+	}
+
+	SubsystemScheduler::nanosecondsType SubsystemScheduler::getNextDueTime() const {
+		nanosecondsType toRet{ nanosecondsType::max() };
+		for (const Subsystem& subsystem : subsystems) {
+			if (subsystem.nextDueTime < toRet) {
+				toRet = subsystem.nextDueTime;
+			}
+		}
+		return toRet;
+	}
+
+	SubsystemScheduler::nanosecondsType SubsystemScheduler::calcDueTime(
+		const Subsystem& subsystem
+	) {
+		return subsystem.phaseOffset + nanosecondsType{
+			static_cast<int64_t>(subsystem.scheduleIndex) * nanosecondsPerSecond 
+				/ subsystem.ticksPerSecond
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "TaskGraph.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace wasp::jobs {
+
+	TaskId TaskGraph::addTask(
+		const std::string& name,
+		const std::vector<std::string>& reads,
+		const std::vector<std::string>& writes,
+		const taskFunctionType& function
+	) {
+		if (built) {
+			throw std::runtime_error{ "Error adding task to built graph" };
+		}
+		if (!function) {
+			throw std::invalid_argument{ "Error task has no function" };
+		}
+		auto task{ std::make_unique<Task>() };
+		task->name = name;
+		task->reads = reads;
+		task->writes = writes;
+		task->function = function;
+		tasks.push_back(std::move(task));
+		return tasks.size() - 1;
+	}
+
+	void TaskGraph::build() {
+		if (built) {
+			return;
+		}
+		struct ResourceState {
+			bool written{};
+			TaskId lastWriter{};
+			std::vector<TaskId> readersSinceWrite{};
+		};
+		std::unordered_map<std::string, ResourceState> resources{};
+
+		//dependencies only ever point back to earlier tasks, so there can't be
+		//a cycle and the add order is a valid run order
+		for (TaskId id{ 0 }; id < tasks.size(); ++id) {
+			Task& task{ *tasks[id] };
+			std::vector<TaskId>& predecessors{ task.predecessors };
+			for (const std::string& resourceName : task.reads) {
+				ResourceState& resource{ resources[resourceName] };
+				if (resource.written) {
+					predecessors.push_back(resource.lastWriter);
+				}
+			}
+			for (const std::string& resourceName : task.writes) {
+				ResourceState& resource{ resources[resourceName] };
+				if (resource.written) {
+					predecessors.push_back(resource.lastWriter);
+				}
+				predecessors.insert(
+					predecessors.end(),
+					resource.readersSinceWrite.begin(),
+					resource.readersSinceWrite.end()
+				);
+			}
+			std::sort(predecessors.begin(), predecessors.end());
+			predecessors.erase(
+				std::unique(predecessors.begin(), predecessors.end()), 
+				predecessors.end()
+			);
+			//a task reading and writing the same thing doesn't wait on itself
+			predecessors.erase(
+				std::remove(predecessors.begin(), predecessors.end(), id),
+				predecessors.end()
+			);
+
+			//after working out predecessors, so a read-write task doesn't see
+			//its own read
+			for (const std::string& resourceName : task.reads) {
+				resources[resourceName].readersSinceWrite.push_back(id);
+			}
+			for (const std::string& resourceName : task.writes) {
+				ResourceState& resource{ resources[resourceName] };
+				resource.written = true;
+				resource.lastWriter = id;
+				resource.readersSinceWrite.clear();
+			}
+
+			for (TaskId predecessor : predecessors) {
+				tasks[predecessor]->successors.push_back(id);
+			}
+			if (predecessors.empty()) {
+				rootTasks.push_back(id);
+			}
+		}
+
+		pathSeconds.resize(tasks.size());
+		pathPrevious.resize(tasks.size());
+		criticalPath.tasks.reserve(tasks.size());
+		built = true;
+	}
+
+	void TaskGraph::run(JobSystem& jobSystem) {
+		if (!built) {
+			build();
+		}
+		for (const std::unique_ptr<Task>& task : tasks) {
+			task->remainingPredecessors.store(
+				task->predecessors.size(), 
+				std::memory_order_relaxed
+			);
+		}
+		JobCounter counter{};
+		for (TaskId id : rootTasks) {
+			schedule(jobSystem, counter, id);
+		}
+		jobSystem.wait(counter);
+		updateCriticalPath();
+	}
+
+	void TaskGraph::schedule(JobSystem& jobSystem, JobCounter& counter, TaskId id) {
+		jobSystem.run(counter, [this, &jobSystem, &counter, id] {
+			runTask(jobSystem, counter, id);
+		});
+	}
+
+	//successors are scheduled before this job finishes, so the counter can't
+	//reach zero while anything is left
+	void TaskGraph::runTask(JobSystem& jobSystem, JobCounter& counter, TaskId id) {
+		Task& task{ *tasks[id] };
+		task.begin = clockType::now();
+		task.function();
+		task.end = clockType::now();
+		for (TaskId successor : task.successors) {
+			if (tasks[successor]->remainingPredecessors.fetch_sub(
+				1, 
+				std::memory_order_acq_rel
+			) == 1) {
+				schedule(jobSystem, counter, successor);
+			}
+		}
+	}
+
+	double TaskGraph::getTaskSeconds(TaskId id) const {
+		const Task& task{ *tasks.at(id) };
+		return std::chrono::duration<double>{ task.end - task.begin }.count();
+	}
+
+	//longest chain of measured task times, walking tasks in add order since
+	//that is a topological order
+	void TaskGraph::updateCriticalPath() {
+		criticalPath.tasks.clear();
+		criticalPath.seconds = 0.0;
+		if (tasks.empty()) {
+			return;
+		}
+		TaskId last{ 0 };
+		for (TaskId id{ 0 }; id < tasks.size(); ++id) {
+			double longestBefore{ 0.0 };
+			pathPrevious[id] = id;
+			for (TaskId predecessor : tasks[id]->predecessors) {
+				if (pathSeconds[predecessor] > longestBefore) {
+					longestBefore = pathSeconds[predecessor];
+					pathPrevious[id] = predecessor;
+				}
+			}
+			pathSeconds[id] = longestBefore + getTaskSeconds(id);
+			if (pathSeconds[id] > pathSeconds[last]) {
+				last = id;
+			}
+		}
+		criticalPath.seconds = pathSeconds[last];
+		TaskId current{ last };
+		while (true) {
+			criticalPath.tasks.push_back(current);
+			if (pathPrevious[current] == current) {
+				break;
+			}
+			current = pathPrevious[current];
+		}
+		std::reverse(criticalPath.tasks.begin(), criticalPath.tasks.end());
+	}
+
+	std::string TaskGraph::formatCriticalPath() const {
+		std::ostringstream outStream{};
+		for (std::size_t i{ 0 }; i < criticalPath.tasks.size(); ++i) {
+			const TaskId id{ criticalPath.tasks[i] };
+			if (i > 0) {
+				outStream << " -> ";
+			}
+			outStream << tasks[id]->name << ' ' << getTaskSeconds(id) * 1000.0 << "ms";
+		}
+		return outStream.str();
+	}
+}
\ No newline at end of file
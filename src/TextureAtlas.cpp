@@ -0,0 +1,213 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace wasp::graphics {
+
+	SkylinePacker::SkylinePacker(int width, int height)
+		: width{ width }
+		, height{ height } {
+		if (width <= 0 || height <= 0) {
+			throw std::invalid_argument{ "Error packer size must be positive" };
+		}
+		reset();
+	}
+
+	void SkylinePacker::reset() {
+		skyline.clear();
+		skyline.push_back({ 0, 0, width });
+		usedHeight = 0;
+	}
+
+	bool SkylinePacker::insert(int rectangleWidth, int rectangleHeight, int& x, int& y) {
+		std::size_t bestIndex{ skyline.size() };
+		int bestY{};
+		int bestWidth{};
+		for (std::size_t i{ 0 }; i < skyline.size(); ++i) {
+			const int fitY{ findY(i, rectangleWidth, rectangleHeight) };
+			if (fitY < 0) {
+				continue;
+			}
+			//lowest top, then the narrowest segment to leave wide gaps open
+			if (bestIndex == skyline.size()
+				|| fitY < bestY
+				|| (fitY == bestY && skyline[i].width < bestWidth)
+			) {
+				bestIndex = i;
+				bestY = fitY;
+				bestWidth = skyline[i].width;
+			}
+		}
+		if (bestIndex == skyline.size()) {
+			return false;
+		}
+
+		x = skyline[bestIndex].x;
+		y = bestY;
+		addSegment(bestIndex, x, y + rectangleHeight, rectangleWidth);
+		usedHeight = std::max(usedHeight, y + rectangleHeight);
+		return true;
+	}
+
+	int SkylinePacker::findY(
+		std::size_t index, 
+		int rectangleWidth, 
+		int rectangleHeight
+	) const {
+		if (skyline[index].x + rectangleWidth > width) {
+			return -1;
+		}
+		//the rectangle rests on the highest segment under it
+		int y{};
+		int widthLeft{ rectangleWidth };
+		for (std::size_t i{ index }; widthLeft > 0; ++i) {
+			y = std::max(y, skyline[i].y);
+			if (y + rectangleHeight > height) {
+				return -1;
+			}
+			widthLeft -= skyline[i].width;
+		}
+		return y;
+	}
+
+	void SkylinePacker::addSegment(std::size_t index, int x, int y, int rectangleWidth) {
+		skyline.insert(skyline.begin() + index, { x, y, rectangleWidth });
+
+		//cut away what the new segment covers
+		const int right{ x + rectangleWidth };
+		std::size_t i{ index + 1 };
+		while (i < skyline.size() && skyline[i].x < right) {
+			Segment& segment{ skyline[i] };
+			const int segmentRight{ segment.x + segment.width };
+			if (segmentRight <= right) {
+				skyline.erase(skyline.begin() + i);
+			}
+			else {
+				segment.width = segmentRight - right;
+				segment.x = right;
+				break;
+			}
+		}
+
+		//merge neighbours at the same height
+		for (std::size_t j{ 0 }; j + 1 < skyline.size(); ) {
+			if (skyline[j].y == skyline[j + 1].y) {
+				skyline[j].width += skyline[j + 1].width;
+				skyline.erase(skyline.begin() + j + 1);
+			}
+			else {
+				++j;
+			}
+		}
+	}
+
+	TextureAtlasBuilder::TextureAtlasBuilder(int pageSize, int padding)
+		: pageSize{ pageSize }
+		, padding{ padding } {
+		if (pageSize <= 0 || padding < 0) {
+			throw std::invalid_argument{ "Error invalid atlas page size or padding" };
+		}
+	}
+
+	std::vector<AtlasPlacement> TextureAtlasBuilder::build(
+		utility::Span<const SoftwareBitmap> images
+	) {
+		pages.clear();
+		packedImagePixels = 0;
+		std::vector<AtlasPlacement> placements(images.size());
+
+		//tallest first packs a skyline much flatter
+		std::vector<std::size_t> order(images.size());
+		std::iota(order.begin(), order.end(), std::size_t{ 0 });
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+			return images.data()[a].height > images.data()[b].height;
+		});
+
+		std::vector<SkylinePacker> packers{};
+		for (std::size_t imageIndex : order) {
+			const SoftwareBitmap& image{ images.data()[imageIndex] };
+			const int paddedWidth{ image.width + padding * 2 };
+			const int paddedHeight{ image.height + padding * 2 };
+			if (image.width <= 0 || image.height <= 0
+				|| paddedWidth > pageSize || paddedHeight > pageSize
+			) {
+				continue;
+			}
+
+			int x{};
+			int y{};
+			std::size_t page{ 0 };
+			while (page < packers.size()
+				&& !packers[page].insert(paddedWidth, paddedHeight, x, y)
+			) {
+				++page;
+			}
+			if (page == packers.size()) {
+				packers.emplace_back(pageSize, pageSize);
+				pages.push_back({
+					pageSize,
+					pageSize,
+					std::vector<uint32_t>(static_cast<std::size_t>(pageSize) * pageSize)
+				});
+				packers.back().insert(paddedWidth, paddedHeight, x, y);
+			}
+
+			copyWithPadding(image, pages[page], x, y);
+			placements[imageIndex] = {
+				static_cast<int>(page),
+				{
+					static_cast<float>(x + padding),
+					static_cast<float>(y + padding),
+					static_cast<float>(image.width),
+					static_cast<float>(image.height)
+				}
+			};
+			packedImagePixels += static_cast<uint64_t>(image.width) * image.height;
+		}
+
+		if (!pages.empty()) {
+			SoftwareBitmap& lastPage{ pages.back() };
+			lastPage.height = packers.back().getUsedHeight();
+			lastPage.pixels.resize(static_cast<std::size_t>(lastPage.width) * lastPage.height);
+		}
+		return placements;
+	}
+
+	double TextureAtlasBuilder::getEfficiency() const {
+		uint64_t pagePixels{};
+		for (const SoftwareBitmap& page : pages) {
+			pagePixels += static_cast<uint64_t>(page.width) * page.height;
+		}
+		if (pagePixels == 0) {
+			return 0.0;
+		}
+		return static_cast<double>(packedImagePixels) / pagePixels;
+	}
+
+	void TextureAtlasBuilder::copyWithPadding(
+		const SoftwareBitmap& image,
+		SoftwareBitmap& page,
+		int x,
+		int y
+	) const {
+		//x and y are the corner of the padding, edge pixels repeat outwards
+		for (int row{ 0 }; row < image.height + padding * 2; ++row) {
+			const int sourceRow{ std::clamp(row - padding, 0, image.height - 1) };
+			const uint32_t* source{ 
+				image.pixels.data() + static_cast<std::size_t>(sourceRow) * image.width 
+			};
+			uint32_t* destination{
+				page.pixels.data() + static_cast<std::size_t>(y + row) * page.width + x
+			};
+			std::fill(destination, destination + padding, source[0]);
+			std::copy(source, source + image.width, destination + padding);
+			std::fill(
+				destination + padding + image.width,
+				destination + padding * 2 + image.width,
+				source[image.width - 1]
+			);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "TimerService.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace wasp::time {
+
+	namespace {
+		std::atomic<uint64_t> nextSerialNumber{ 1 };
+	}
+
+	TimerService::TimerService(std::chrono::microseconds spinMargin)
+		: spinMargin{ spinMargin }
+		, serialNumber{ nextSerialNumber.fetch_add(1, std::memory_order_relaxed) } {
+	}
+
+	TimerService::~TimerService() {
+		stop();
+	}
+
+	void TimerService::start() {
+		if (thread.joinable()) {
+			return;
+		}
+		running = true;
+		thread = std::thread{ [&] { timerLoop(); } };
+	}
+
+	void TimerService::stop() {
+		std::vector<std::shared_ptr<Mailbox>> toRelease{};
+		{
+			std::lock_guard<std::mutex> lock{ timerMutex };
+			running = false;
+			deadlineHeap.clear();
+			timers.clear();
+			for (auto& [threadId, mailbox] : mailboxes) {
+				toRelease.push_back(mailbox);
+			}
+		}
+		timerCondition.notify_all();
+		for (const std::shared_ptr<Mailbox>& mailbox : toRelease) {
+			{
+				std::lock_guard<std::mutex> lock{ mailbox->mutex };
+			}
+			mailbox->condition.notify_all();
+		}
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+
+	TimerId TimerService::addOneShot(
+		timePointType deadline,
+		const callbackType& callback,
+		TimerDelivery delivery
+	) {
+		return addTimer(deadline, durationType::zero(), callback, delivery);
+	}
+
+	TimerId TimerService::addPeriodic(
+		timePointType firstDeadline,
+		durationType period,
+		const callbackType& callback,
+		TimerDelivery delivery
+	) {
+		if (period <= durationType::zero()) {
+			throw std::invalid_argument{ "Error timer period <= 0" };
+		}
+		return addTimer(firstDeadline, period, callback, delivery);
+	}
+
+	TimerId TimerService::addTimer(
+		timePointType firstDeadline,
+		durationType period,
+		const callbackType& callback,
+		TimerDelivery delivery
+	) {
+		if (!callback) {
+			throw std::invalid_argument{ "Error timer has no callback" };
+		}
+		Timer timer{};
+		timer.callback = std::make_shared<const callbackType>(callback);
+		timer.period = period;
+		timer.deadline = firstDeadline;
+
+		TimerId id{};
+		bool isEarliest{};
+		{
+			std::lock_guard<std::mutex> lock{ timerMutex };
+			if (delivery == TimerDelivery::registeringThread) {
+				timer.mailbox = getMailbox(std::this_thread::get_id());
+			}
+			id = nextId++;
+			timers.emplace(id, std::move(timer));
+			isEarliest = deadlineHeap.empty() || firstDeadline < deadlineHeap.front().deadline;
+			deadlineHeap.push_back({ firstDeadline, id });
+			std::push_heap(deadlineHeap.begin(), deadlineHeap.end());
+		}
+		//only a new earliest deadline changes how long the timing thread sleeps
+		if (isEarliest) {
+			timerCondition.notify_one();
+		}
+		return id;
+	}
+
+	bool TimerService::cancel(TimerId id) {
+		std::lock_guard<std::mutex> lock{ timerMutex };
+		return timers.erase(id) > 0;
+	}
+
+	std::size_t TimerService::dispatch() {
+		//cached so the common nothing-to-do case is one atomic load
+		thread_local uint64_t cachedSerialNumber{ 0 };
+		thread_local std::shared_ptr<Mailbox> cachedMailbox{};
+		if (cachedSerialNumber != serialNumber) {
+			std::lock_guard<std::mutex> lock{ timerMutex };
+			cachedMailbox = getMailbox(std::this_thread::get_id());
+			cachedSerialNumber = serialNumber;
+		}
+		Mailbox& mailbox{ *cachedMailbox };
+		if (mailbox.callbackCount.load(std::memory_order_acquire) == 0) {
+			return 0;
+		}
+
+		std::deque<std::shared_ptr<const callbackType>> toRun{};
+		{
+			std::lock_guard<std::mutex> lock{ mailbox.mutex };
+			toRun.swap(mailbox.callbacks);
+			mailbox.callbackCount.store(0, std::memory_order_relaxed);
+		}
+		for (const std::shared_ptr<const callbackType>& callback : toRun) {
+			(*callback)();
+		}
+		return toRun.size();
+	}
+
+	bool TimerService::sleepUntil(timePointType deadline) {
+		std::shared_ptr<Mailbox> mailbox{};
+		{
+			std::lock_guard<std::mutex> lock{ timerMutex };
+			if (!running) {
+				return false;
+			}
+			mailbox = getMailbox(std::this_thread::get_id());
+		}
+		//the wake up is a timer of its own, so it shares the spin with the rest
+		auto woken{ std::make_shared<std::atomic_bool>(false) };
+		addOneShot(deadline, [woken] { woken->store(true); });
+
+		while (!woken->load()) {
+			{
+				std::unique_lock<std::mutex> lock{ mailbox->mutex };
+				mailbox->condition.wait(lock, [&] {
+					return mailbox->callbackCount.load(std::memory_order_relaxed) > 0
+						|| !running;
+				});
+			}
+			dispatch();
+			std::lock_guard<std::mutex> lock{ timerMutex };
+			if (!running) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//timerMutex must be held
+	std::shared_ptr<TimerService::Mailbox> TimerService::getMailbox(
+		std::thread::id threadId
+	) {
+		std::shared_ptr<Mailbox>& mailbox{ mailboxes[threadId] };
+		if (!mailbox) {
+			mailbox = std::make_shared<Mailbox>();
+		}
+		return mailbox;
+	}
+
+	void TimerService::timerLoop() {
+		std::unique_lock<std::mutex> lock{ timerMutex };
+		while (running) {
+			if (deadlineHeap.empty()) {
+				timerCondition.wait(lock);
+				continue;
+			}
+			const timePointType deadline{ deadlineHeap.front().deadline };
+			const timePointType sleepUntil{ deadline - spinMargin };
+			if (now() < sleepUntil) {
+				//wakes early for a new earliest deadline or stop
+				timerCondition.wait_until(lock, sleepUntil);
+				continue;
+			}
+			//spin without the lock so registering isn't held up
+			lock.unlock();
+			while (now() < deadline) {}
+			lock.lock();
+			fireDueTimers(lock);
+		}
+	}
+
+	//fires everything due, releasing the lock around inline callbacks
+	void TimerService::fireDueTimers(std::unique_lock<std::mutex>& lock) {
+		const timePointType currentTime{ now() };
+		while (running 
+			&& !deadlineHeap.empty() 
+			&& deadlineHeap.front().deadline <= currentTime
+		) {
+			std::pop_heap(deadlineHeap.begin(), deadlineHeap.end());
+			const HeapEntry entry{ deadlineHeap.back() };
+			deadlineHeap.pop_back();
+
+			auto timerIter{ timers.find(entry.id) };
+			//cancelled, or a stale entry from before a timer was rescheduled
+			if (timerIter == timers.end() || timerIter->second.deadline != entry.deadline) {
+				continue;
+			}
+			Timer& timer{ timerIter->second };
+			const std::shared_ptr<const callbackType> callback{ timer.callback };
+			const std::shared_ptr<Mailbox> mailbox{ timer.mailbox };
+
+			if (timer.period > durationType::zero()) {
+				timer.deadline += timer.period;
+				if (timer.deadline <= currentTime) {
+					const auto periodsBehind{ (currentTime - timer.deadline) / timer.period };
+					timer.deadline += timer.period * (periodsBehind + 1);
+				}
+				deadlineHeap.push_back({ timer.deadline, entry.id });
+				std::push_heap(deadlineHeap.begin(), deadlineHeap.end());
+			}
+			else {
+				timers.erase(timerIter);
+			}
+
+			if (mailbox) {
+				deliver(callback, mailbox);
+			}
+			else {
+				lock.unlock();
+				(*callback)();
+				lock.lock();
+			}
+		}
+	}
+
+	void TimerService::deliver(
+		const std::shared_ptr<const callbackType>& callback,
+		const std::shared_ptr<Mailbox>& mailbox
+	) {
+		{
+			std::lock_guard<std::mutex> lock{ mailbox->mutex };
+			mailbox->callbacks.push_back(callback);
+			mailbox->callbackCount.fetch_add(1, std::memory_order_release);
+		}
+		mailbox->condition.notify_one();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "TscClock.h"
+
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef __GNUC__
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#endif
+
+namespace wasp::time {
+
+	namespace {
+		constexpr uint32_t advancedPowerManagementLeaf{ 0x80000007 };
+		constexpr uint32_t invariantTscBit{ 1u << 8 };	//in edx
+
+		//a steady_clock reading and the counter value at the same instant
+		struct SamplePair {
+			uint64_t ticks{};
+			TscClock::time_point time{};
+		};
+
+		#ifdef WASP_TSC_READABLE
+		//brackets a steady_clock read with counter reads and keeps the tightest
+		//of a few tries, so the pair isn't skewed by an interrupt in between
+		SamplePair takeSamplePair() {
+			constexpr int tries{ 16 };
+
+			SamplePair toRet{};
+			uint64_t narrowestWindow{ UINT64_MAX };
+			for (int i{ 0 }; i < tries; ++i) {
+				const uint64_t before{ __rdtsc() };
+				const TscClock::time_point time{ TscClock::baseClockType::now() };
+				const uint64_t after{ __rdtsc() };
+				if (after - before < narrowestWindow) {
+					narrowestWindow = after - before;
+					toRet.ticks = before + (after - before) / 2;
+					toRet.time = time;
+				}
+			}
+			return toRet;
+		}
+		#endif
+	}
+
+	TscClock::Calibration TscClock::calibration{};
+
+	bool TscClock::isTscInvariant() {
+		#ifdef WASP_TSC_READABLE
+		uint32_t registers[4]{};	//eax, ebx, ecx, edx
+
+		#ifdef _MSC_VER
+		int msvcRegisters[4]{};
+		__cpuid(msvcRegisters, static_cast<int>(advancedPowerManagementLeaf & 0x80000000));
+		if (static_cast<uint32_t>(msvcRegisters[0]) < advancedPowerManagementLeaf) {
+			return false;
+		}
+		__cpuid(msvcRegisters, static_cast<int>(advancedPowerManagementLeaf));
+		for (int i{ 0 }; i < 4; ++i) {
+			registers[i] = static_cast<uint32_t>(msvcRegisters[i]);
+		}
+		#endif
+
+		#ifdef __GNUC__
+		if (__get_cpuid_max(advancedPowerManagementLeaf & 0x80000000, nullptr) 
+			< advancedPowerManagementLeaf
+		) {
+			return false;
+		}
+		__cpuid(
+			advancedPowerManagementLeaf,
+			registers[0],
+			registers[1],
+			registers[2],
+			registers[3]
+		);
+		#endif
+
+		return registers[3] & invariantTscBit;
+		#else
+		return false;
+		#endif
+	}
+
+	void TscClock::calibrate(std::chrono::milliseconds calibrationTime) {
+		calibration = Calibration{};
+		#ifdef WASP_TSC_READABLE
+		if (!isTscInvariant()) {
+			return;
+		}
+		const SamplePair start{ takeSamplePair() };
+		std::this_thread::sleep_for(calibrationTime);
+		const SamplePair end{ takeSamplePair() };
+
+		const double elapsedNanoseconds{
+			std::chrono::duration<double, std::nano>{ end.time - start.time }.count()
+		};
+		const uint64_t elapsedTicks{ end.ticks - start.ticks };
+		if (elapsedNanoseconds <= 0.0 || elapsedTicks == 0) {
+			return;
+		}
+
+		Calibration newCalibration{};
+		newCalibration.usingTsc = true;
+		newCalibration.baseTicks = end.ticks;
+		newCalibration.baseTime = end.time;
+		newCalibration.nanosecondsPerTick 
+			= elapsedNanoseconds / static_cast<double>(elapsedTicks);
+		calibration = newCalibration;
+		#endif
+	}
+}
\ No newline at end of file
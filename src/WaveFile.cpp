@@ -0,0 +1,173 @@
+#include "WaveFile.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "compiler.h"
+
+namespace wasp::sound::wave {
+
+	using namespace constants;
+
+	PACKED(
+	struct RiffHeader {
+		uint32_t id{};		// "RIFF"
+		uint32_t size{};	// size of everything after this field
+		uint32_t format{};	// "WAVE"
+	});
+
+	PACKED(
+	struct ChunkHeader {
+		uint32_t id{};
+		uint32_t size{};	// does not include the pad byte of odd sized chunks
+	});
+
+	template <typename T>
+	static T readAt(utility::Span<const std::byte> bytes, std::size_t offset) {
+		if (offset > bytes.size() || sizeof(T) > bytes.size() - offset) {
+			throw std::runtime_error{ "Error WAV file truncated" };
+		}
+		T toRet{};
+		std::memcpy(&toRet, bytes.data() + offset, sizeof(T));
+		return toRet;
+	}
+
+	WaveFileView parseWaveFile(utility::Span<const std::byte> fileBytes) {
+		RiffHeader riffHeader{ readAt<RiffHeader>(fileBytes, 0) };
+		if (riffHeader.id != riffID) {
+			throw std::runtime_error{ "Error WAV file invalid RIFF identifier" };
+		}
+		if (riffHeader.format != waveID) {
+			throw std::runtime_error{ "Error WAV file invalid WAVE identifier" };
+		}
+
+		//some writers pad or truncate the file, trust the smaller of the two
+		std::size_t riffEnd{ sizeof(uint32_t) * 2 + riffHeader.size };
+		if (riffEnd > fileBytes.size()) {
+			riffEnd = fileBytes.size();
+		}
+
+		WaveFileView toRet{};
+		bool foundFormat{ false };
+		bool foundData{ false };
+		std::size_t offset{ sizeof(RiffHeader) };
+		while (offset + sizeof(ChunkHeader) <= riffEnd && !foundData) {
+			ChunkHeader chunkHeader{ readAt<ChunkHeader>(fileBytes, offset) };
+			offset += sizeof(ChunkHeader);
+			if (chunkHeader.size > riffEnd - offset) {
+				throw std::runtime_error{ "Error WAV chunk exceeds file size" };
+			}
+
+			if (chunkHeader.id == formatID) {
+				if (chunkHeader.size < minimumFormatSize) {
+					throw std::runtime_error{ "Error WAV format chunk too small" };
+				}
+				toRet.format = readAt<WaveFormat>(fileBytes, offset);
+				foundFormat = true;
+			}
+			else if (chunkHeader.id == dataID) {
+				if (!foundFormat) {
+					throw std::runtime_error{ "Error WAV data chunk before format" };
+				}
+				toRet.pcmData = fileBytes.subspan(offset, chunkHeader.size);
+				foundData = true;
+			}
+
+			//chunks are word aligned
+			offset += chunkHeader.size + (chunkHeader.size & 1);
+		}
+
+		if (!foundFormat) {
+			throw std::runtime_error{ "Error WAV file missing format chunk" };
+		}
+		if (!foundData) {
+			throw std::runtime_error{ "Error WAV file missing data chunk" };
+		}
+		throwIfFormatUnsupported(toRet.format);
+		if (toRet.pcmData.size() % toRet.format.blockAlign != 0) {
+			throw std::runtime_error{ "Error WAV data not a whole number of frames" };
+		}
+
+		return toRet;
+	}
+
+	template <typename T>
+	static T readFrom(std::istream& inStream) {
+		T toRet{};
+		inStream.read(reinterpret_cast<char*>(&toRet), sizeof(T));
+		if (!inStream) {
+			throw std::runtime_error{ "Error WAV file truncated" };
+		}
+		return toRet;
+	}
+
+	WaveStreamHeader readWaveStreamHeader(std::istream& inStream) {
+		RiffHeader riffHeader{ readFrom<RiffHeader>(inStream) };
+		if (riffHeader.id != riffID) {
+			throw std::runtime_error{ "Error WAV file invalid RIFF identifier" };
+		}
+		if (riffHeader.format != waveID) {
+			throw std::runtime_error{ "Error WAV file invalid WAVE identifier" };
+		}
+
+		WaveStreamHeader toRet{};
+		bool foundFormat{ false };
+		while (true) {
+			ChunkHeader chunkHeader{ readFrom<ChunkHeader>(inStream) };
+			uint32_t bytesToSkip{ chunkHeader.size + (chunkHeader.size & 1) };
+
+			if (chunkHeader.id == formatID) {
+				if (chunkHeader.size < minimumFormatSize) {
+					throw std::runtime_error{ "Error WAV format chunk too small" };
+				}
+				toRet.format = readFrom<WaveFormat>(inStream);
+				bytesToSkip -= sizeof(WaveFormat);
+				foundFormat = true;
+			}
+			else if (chunkHeader.id == dataID) {
+				if (!foundFormat) {
+					throw std::runtime_error{ "Error WAV data chunk before format" };
+				}
+				toRet.dataSize = chunkHeader.size;
+				break;
+			}
+
+			inStream.ignore(bytesToSkip);
+		}
+
+		throwIfFormatUnsupported(toRet.format);
+		if (toRet.dataSize % toRet.format.blockAlign != 0) {
+			throw std::runtime_error{ "Error WAV data not a whole number of frames" };
+		}
+
+		return toRet;
+	}
+
+	void throwIfFormatUnsupported(const WaveFormat& format) {
+		if (format.formatTag != formatPCM
+			&& format.formatTag != formatIEEEFloat
+			&& format.formatTag != formatExtensible
+		) {
+			throw std::runtime_error{ "Error WAV compressed formats unsupported" };
+		}
+		if (format.channels == 0) {
+			throw std::runtime_error{ "Error WAV file has no channels" };
+		}
+		if (format.samplesPerSecond == 0) {
+			throw std::runtime_error{ "Error WAV file has no sample rate" };
+		}
+		if (format.bitsPerSample == 0 || format.bitsPerSample % 8 != 0) {
+			throw std::runtime_error{ "Error WAV bits per sample unsupported" };
+		}
+		if (format.blockAlign != format.channels * (format.bitsPerSample / 8)) {
+			throw std::runtime_error{ "Error WAV block align inconsistent" };
+		}
+		//streaming sizes its buffer and paces its reads from this, in 64 bits so
+		//a garbage sample rate can't wrap around to a match
+		if (format.averageBytesPerSecond
+			!= static_cast<uint64_t>(format.samplesPerSecond) * format.blockAlign
+		) {
+			throw std::runtime_error{ "Error WAV byte rate inconsistent" };
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "WaveStorage.h"
+
+#include "FileUtil.h"
+
+namespace wasp::game::gameresource {
+
+	//maps the file again before swapping, so a stream still reading the old
+	//mapping keeps it alive until it lets go
+	void WaveStorage::reload(const std::wstring& id) {
+		if (resourceLoaderPointer) {
+			std::shared_ptr<ResourceType> resourcePointer{ findResource(id) };
+			if (resourcePointer) {
+				const resource::ResourceOriginVariant origin{
+					resourcePointer->getOrigin()
+				};
+				switch (origin.index()) {
+					case 0: {
+						resource::FileOrigin const* fileTest{
+							std::get_if<resource::FileOrigin>(&origin)
+						};
+						if (fileTest) {
+							replaceResource(
+								id,
+								makeResource(id, fileTest->fileName, origin)
+							);
+						}
+						break;
+					}
+					case 1: {
+						resource::ManifestOrigin const* manifestTest{
+							std::get_if<resource::ManifestOrigin>(&origin)
+						};
+						if (manifestTest) {
+							replaceResource(
+								id,
+								makeResource(
+									id,
+									manifestTest->manifestArguments[1],
+									origin
+								)
+							);
+						}
+						break;
+					}
+				}
+			}
+		}
+		else {
+			throw std::runtime_error{ "Error trying to reload without loader" };
+		}
+	}
+
+	resource::ResourceBase* WaveStorage::loadFromFile(
+		const resource::FileOrigin& fileOrigin,
+		const resource::ResourceLoader& resourceLoader
+	) {
+		const std::wstring& id{ file::getFileName(fileOrigin.fileName) };
+		if (findResource(id)) {
+			throw std::runtime_error{ "Error loaded pre-existing id" };
+		}
+
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			makeResource(id, fileOrigin.fileName, fileOrigin)
+		};
+		insertResource(id, resourceSharedPointer);
+		return resourceSharedPointer.get();
+	}
+
+	resource::ResourceBase* WaveStorage::loadFromManifest(
+		const resource::ManifestOrigin& manifestOrigin,
+		const resource::ResourceLoader& resourceLoader
+	) {
+		const std::wstring& fileName{ manifestOrigin.manifestArguments[1] };
+
+		const std::wstring& id{ file::getFileName(fileName) };
+		if (findResource(id)) {
+			throw std::runtime_error{ "Error loaded pre-existing id" };
+		}
+
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			makeResource(id, fileName, manifestOrigin)
+		};
+		insertResource(id, resourceSharedPointer);
+		return resourceSharedPointer.get();
+	}
+
+	std::shared_ptr<WaveStorage::ResourceType> WaveStorage::makeResource(
+		const std::wstring& id,
+		const std::wstring& fileName,
+		const resource::ResourceOriginVariant& origin
+	) {
+		std::shared_ptr<ResourceType> resourceSharedPointer{
+			std::make_shared<ResourceType>(
+				id,
+				origin,
+				mapWaveFile(fileName)
+			)
+		};
+
+		resourceSharedPointer->setStoragePointer(this);
+		return resourceSharedPointer;
+	}
+
+	std::shared_ptr<WaveData> WaveStorage::mapWaveFile(const std::wstring& fileName) {
+		std::shared_ptr<WaveData> waveDataPointer{ std::make_shared<WaveData>() };
+		waveDataPointer->mappedFile = file::MappedFile{ fileName };
+
+		//the view stays valid as long as the mapped file lives in the same WaveData
+		const sound::wave::WaveFileView waveFileView{
+			sound::wave::parseWaveFile(waveDataPointer->mappedFile.getBytes())
+		};
+		waveDataPointer->format = waveFileView.format;
+		waveDataPointer->pcmData = waveFileView.pcmData;
+
+		return waveDataPointer;
+	}
+}
\ No newline at end of file
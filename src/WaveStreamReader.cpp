@@ -0,0 +1,207 @@
+#include "WaveStreamReader.h"
+
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace wasp::sound {
+
+	static std::ifstream openBinaryFile(const std::wstring& fileName) {
+		std::ifstream toRet{ std::filesystem::path{ fileName }, std::ios::binary };
+		if (!toRet) {
+			throw std::runtime_error{ "Error opening WAV file for streaming" };
+		}
+		return toRet;
+	}
+
+	static std::size_t roundUpToMultiple(std::size_t value, std::size_t multiple) {
+		return ((value + multiple - 1) / multiple) * multiple;
+	}
+
+	static std::size_t calcBufferBytes(
+		const wave::WaveFormat& format,
+		double bufferSeconds,
+		std::size_t chunkBytes
+	) {
+		std::size_t bufferBytes{
+			static_cast<std::size_t>(bufferSeconds * format.averageBytesPerSecond)
+		};
+		//always room for a chunk in flight plus one queued
+		return std::max(bufferBytes, chunkBytes * 2);
+	}
+
+	WaveStreamReader::WaveStreamReader(
+		const std::wstring& fileName,
+		bool looping,
+		double bufferSeconds,
+		std::size_t chunkBytes
+	)
+		: inStream{ openBinaryFile(fileName) }
+		, header{ wave::readWaveStreamHeader(inStream) }
+		, dataStart{ inStream.tellg() }
+		, dataRemaining{ header.dataSize }
+		, looping{ looping }
+		, chunkBuffer(roundUpToMultiple(chunkBytes, header.format.blockAlign))
+		, ringBuffer{ calcBufferBytes(header.format, bufferSeconds, chunkBuffer.size()) } {
+
+		if (header.dataSize == 0) {
+			throw std::runtime_error{ "Error cannot stream empty WAV data" };
+		}
+	}
+
+	WaveStreamReader::~WaveStreamReader() {
+		stop();
+	}
+
+	void WaveStreamReader::start() {
+		if (fillThread.joinable()) {
+			return;
+		}
+		while (ringBuffer.freeSpace() >= chunkBuffer.size() && fillChunk());
+		minimumBufferFill.store(ringBuffer.size(), std::memory_order_relaxed);
+
+		stopRequested = false;
+		fillThread = std::thread{ [&] { fillLoop(); } };
+	}
+
+	void WaveStreamReader::stop() {
+		{
+			std::lock_guard<std::mutex> lock{ fillMutex };
+			stopRequested = true;
+		}
+		fillCondition.notify_all();
+		if (fillThread.joinable()) {
+			fillThread.join();
+		}
+	}
+
+	void WaveStreamReader::fillLoop() {
+		//sleep roughly half the time it takes to play one chunk between checks
+		const std::chrono::microseconds pollInterval{
+			static_cast<int64_t>(
+				500'000.0 * chunkBuffer.size() / getFormat().averageBytesPerSecond
+			)
+		};
+
+		std::unique_lock<std::mutex> lock{ fillMutex };
+		while (!stopRequested) {
+			lock.unlock();
+			bool moreData{ true };
+			while (ringBuffer.freeSpace() >= chunkBuffer.size() && moreData) {
+				moreData = fillChunk();
+			}
+			lock.lock();
+			if (!moreData) {
+				return;
+			}
+			fillCondition.wait_for(lock, pollInterval, [&] { return stopRequested; });
+		}
+	}
+
+	//returns false when the end of a non looping track has been reached, or
+	//when a looping track has no data left to give after rewinding
+	bool WaveStreamReader::fillChunk() {
+		bool rewound{ false };
+		while (true) {
+			if (dataRemaining == 0) {
+				if (!looping || rewound) {
+					endOfStream.store(true, std::memory_order_release);
+					return false;
+				}
+				inStream.clear();
+				inStream.seekg(dataStart);
+				dataRemaining = header.dataSize;
+				rewound = true;
+			}
+
+			const std::size_t bytesToRead{
+				std::min(chunkBuffer.size(), static_cast<std::size_t>(dataRemaining))
+			};
+
+			const auto readStart{ std::chrono::steady_clock::now() };
+			inStream.read(
+				reinterpret_cast<char*>(chunkBuffer.data()), 
+				static_cast<std::streamsize>(bytesToRead)
+			);
+			std::size_t bytesRead{ static_cast<std::size_t>(inStream.gcount()) };
+			const int64_t readMicroseconds{
+				std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - readStart
+				).count()
+			};
+
+			//the header is checked to be whole frames, so a partial frame only
+			//comes from a truncated file and is dropped, read() would never
+			//hand it out
+			bytesRead -= bytesRead % getFormat().blockAlign;
+			if (bytesRead == 0) {
+				//file shorter than its header claims, treat as the end of the data
+				dataRemaining = 0;
+				continue;
+			}
+			dataRemaining -= static_cast<uint32_t>(bytesRead);
+
+			//space was checked before reading and only we ever add to the buffer
+			ringBuffer.write(chunkBuffer.data(), bytesRead);
+
+			bytesStreamed.fetch_add(bytesRead, std::memory_order_relaxed);
+			chunkReads.fetch_add(1, std::memory_order_relaxed);
+			if (readMicroseconds > slowestReadMicroseconds.load(std::memory_order_relaxed)) {
+				slowestReadMicroseconds.store(readMicroseconds, std::memory_order_relaxed);
+			}
+			return true;
+		}
+	}
+
+	std::size_t WaveStreamReader::read(std::byte* destination, std::size_t byteCount) {
+		const bool ended{ endOfStream.load(std::memory_order_acquire) };
+		std::size_t available{ ringBuffer.size() };
+		available -= available % getFormat().blockAlign;
+
+		//draining at the end of the track isn't a close call
+		if (!ended && available < minimumBufferFill.load(std::memory_order_relaxed)) {
+			minimumBufferFill.store(available, std::memory_order_relaxed);
+		}
+
+		const std::size_t bytesRead{
+			ringBuffer.read(destination, std::min(byteCount, available))
+		};
+		if (bytesRead < byteCount) {
+			std::fill(destination + bytesRead, destination + byteCount, getSilence());
+			//running dry at the end of the track is not an underrun
+			if (!ended) {
+				underruns.fetch_add(1, std::memory_order_relaxed);
+				underrunBytes.fetch_add(byteCount - bytesRead, std::memory_order_relaxed);
+			}
+		}
+		return bytesRead;
+	}
+
+	bool WaveStreamReader::isFinished() const {
+		return endOfStream.load(std::memory_order_acquire) && ringBuffer.size() == 0;
+	}
+
+	StreamStatistics WaveStreamReader::getStatistics() const {
+		return {
+			ringBuffer.capacity(),
+			ringBuffer.size(),
+			minimumBufferFill.load(std::memory_order_relaxed),
+			bytesStreamed.load(std::memory_order_relaxed),
+			chunkReads.load(std::memory_order_relaxed),
+			underruns.load(std::memory_order_relaxed),
+			underrunBytes.load(std::memory_order_relaxed),
+			slowestReadMicroseconds.load(std::memory_order_relaxed)
+		};
+	}
+
+	std::byte WaveStreamReader::getSilence() const {
+		//8 bit PCM is unsigned, everything else is signed or float
+		if (getFormat().formatTag == wave::constants::formatPCM
+			&& getFormat().bitsPerSample == 8
+		) {
+			return std::byte{ 0x80 };
+		}
+		return std::byte{ 0 };
+	}
+}
\ No newline at end of file
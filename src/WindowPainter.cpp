@@ -9,10 +9,15 @@ namespace wasp::window {
 
 	WindowPainter::WindowPainter()
 		: d2dFactoryPointer{ nullptr }
-		, renderTargetPointer{ nullptr } {
+		, renderTargetPointer{ nullptr }
+		, viewportCuller{
+			static_cast<float>(config::graphicsWidth),
+			static_cast<float>(config::graphicsHeight)
+		} {
 	}
 
 	void WindowPainter::init(HWND windowHandle) {
+		this->windowHandle = windowHandle;
 		getDeviceIndependentResources();
 		getDeviceDependentResources(windowHandle);
 	}
@@ -72,6 +77,7 @@ namespace wasp::window {
 			getRenderTargetPointer(windowHandle);
 			makeBufferRenderTargetPointer();
 			makeTextBrushPointer();
+			makeSpriteBatchPointer();
 		}
 	}
 
@@ -118,18 +124,41 @@ namespace wasp::window {
 		) };
 	}
 
+	void WindowPainter::makeSpriteBatchPointer() {
+#ifdef WASP_D2D_SPRITE_BATCH
+		//sprite batches need windows 10 1607, otherwise batches fall back to a loop
+		ID2D1DeviceContext3* rawPointer{};
+		HRESULT result{ bufferRenderTargetPointer->QueryInterface(
+			__uuidof(ID2D1DeviceContext3),
+			reinterpret_cast<void**>(&rawPointer)
+		) };
+		if (FAILED(result)) {
+			return;
+		}
+		deviceContextPointer.Attach(rawPointer);
+		result = deviceContextPointer->CreateSpriteBatch(&spriteBatchPointer);
+		if (FAILED(result)) {
+			deviceContextPointer = nullptr;
+		}
+#endif
+	}
+
 	void WindowPainter::discardDeviceDependentResources()
 	{
+#ifdef WASP_D2D_SPRITE_BATCH
+		spriteBatchPointer = nullptr;
+		deviceContextPointer = nullptr;
+#endif
 		renderTargetPointer = nullptr;
 		bufferRenderTargetPointer = nullptr;
 		textBrushPointer = nullptr;
 	}
 
-	void WindowPainter::paint(HWND windowHandle)
+	//no BeginPaint here, the window validates its own paint messages and
+	//leaves presenting to whichever thread owns the painter
+	void WindowPainter::present(HWND windowHandle)
 	{
 		getDeviceDependentResources(windowHandle);
-		PAINTSTRUCT paintStruct;
-		BeginPaint(windowHandle, &paintStruct);
 
 		renderTargetPointer->BeginDraw();
 
@@ -155,7 +184,6 @@ namespace wasp::window {
 		{
 			discardDeviceDependentResources();
 		}
-		EndPaint(windowHandle, &paintStruct);
 	}
 
 	CComPtr<ID2D1Bitmap> WindowPainter::getBufferBitmap() {
@@ -176,12 +204,15 @@ namespace wasp::window {
 
 			D2D1_SIZE_U size = D2D1::SizeU(rectangle.right, rectangle.bottom);
 
+			//the caller presents afterwards
 			renderTargetPointer->Resize(size);
-			InvalidateRect(windowHandle, NULL, FALSE); //what in the fuck
 		}
 	}
 
 	void WindowPainter::beginDraw() {
+		//remade here if the last present lost the device
+		getDeviceDependentResources(windowHandle);
+		viewportCuller.beginFrame();
 		bufferRenderTargetPointer->BeginDraw();
 		bufferRenderTargetPointer->Clear(D2D1::ColorF{ config::fillColor });
 	}
@@ -204,6 +235,36 @@ namespace wasp::window {
 		);
 	}
 
+	//scales then rotates about the center, the rectangle drawn under it
+	//stays at the unscaled size
+	static D2D1::Matrix3x2F makeTransform(
+		const geometry::Point2 center,
+		float rotationDegrees,
+		float scale
+	) {
+		D2D1_POINT_2F d2dCenter{ center.x, center.y };
+		return makeRotationMatrix(rotationDegrees, d2dCenter)
+			* makeScaleMatrix(scale, d2dCenter);
+	}
+
+	static D2D1::Matrix3x2F makeTransform(
+		const geometry::Point2 center,
+		const graphics::BitmapDrawInstruction& bitmapDrawInstruction
+	) {
+		return makeTransform(
+			center,
+			bitmapDrawInstruction.getRotationDegrees(),
+			bitmapDrawInstruction.getScale()
+		);
+	}
+
+	static bool requiresTransform(
+		const graphics::BitmapDrawInstruction& bitmapDrawInstruction
+	) {
+		return bitmapDrawInstruction.requiresRotation() 
+			|| bitmapDrawInstruction.requiresScale();
+	}
+
 	void WindowPainter::drawBitmap(
 		const geometry::Point2 center,
 		const graphics::BitmapDrawInstruction& bitmapDrawInstruction
@@ -212,87 +273,25 @@ namespace wasp::window {
 
 		ID2D1Bitmap& bitmap{ *bitmapDrawInstruction.getBitmap() };
 		D2D1_SIZE_F originalSize = bitmap.GetSize();
-
-		//only rotation or both rotation and scale
-		if (bitmapDrawInstruction.requiresRotation()) {
-			D2D1_POINT_2F d2dCenter{ center.x, center.y };
-			D2D1::Matrix3x2F transform = makeRotationMatrix(
-				bitmapDrawInstruction.getRotationDegrees(),
-				d2dCenter
-			);
-			//both rotation and scale
-			if (bitmapDrawInstruction.requiresScale()) {
-				transform = transform * makeScaleMatrix(
-					bitmapDrawInstruction.getScale(),
-					d2dCenter
-				);
-				float scaledWidth{ 
-					originalSize.width * bitmapDrawInstruction.getScale() 
-				};
-				float scaledHeight{ 
-					originalSize.height * bitmapDrawInstruction.getScale() 
-				};
-				const geometry::Point2& upperLeft{
-					center.x - (scaledWidth / 2),
-					center.y - (scaledHeight / 2)
-				};
-				makeTransformBitmapDrawCall(
-					bitmap,
-					transform,
-					upperLeft,
-					scaledWidth,
-					scaledHeight,
-					bitmapDrawInstruction.getOpacity()
-				);
-			}
-			//only rotation
-			else {
-				const geometry::Point2& upperLeft{
-					center.x - (originalSize.width / 2),
-					center.y - (originalSize.height / 2)
-				};
-				makeTransformBitmapDrawCall(
-					bitmap,
-					transform,
-					upperLeft,
-					originalSize.width,
-					originalSize.height,
-					bitmapDrawInstruction.getOpacity()
-				);
-			}
+		if (!isVisible(center, originalSize, bitmapDrawInstruction)) {
+			return;
 		}
-		//only scale
-		else if (bitmapDrawInstruction.requiresScale()) {
-			D2D1_POINT_2F d2dCenter{ center.x, center.y };
-			D2D1::Matrix3x2F transform = makeScaleMatrix(
-				bitmapDrawInstruction.getScale(),
-				d2dCenter
-			);
-			float scaledWidth{
-					originalSize.width * bitmapDrawInstruction.getScale()
-			};
-			float scaledHeight{
-				originalSize.height * bitmapDrawInstruction.getScale()
-			};
-			const geometry::Point2& upperLeft{
-				center.x - (scaledWidth / 2),
-				center.y - (scaledHeight / 2)
-			};
+
+		const geometry::Point2 upperLeft{
+			center.x - (originalSize.width / 2),
+			center.y - (originalSize.height / 2)
+		};
+		if (requiresTransform(bitmapDrawInstruction)) {
 			makeTransformBitmapDrawCall(
 				bitmap,
-				transform,
+				makeTransform(center, bitmapDrawInstruction),
 				upperLeft,
-				scaledWidth,
-				scaledHeight,
+				originalSize.width,
+				originalSize.height,
 				bitmapDrawInstruction.getOpacity()
 			);
 		}
-		//normal draw call
 		else {
-			const geometry::Point2& upperLeft{
-				center.x - (originalSize.width / 2),
-				center.y - (originalSize.height / 2)
-			};
 			makeBitmapDrawCall(
 				bitmap,
 				upperLeft,
@@ -312,90 +311,26 @@ namespace wasp::window {
 
 		ID2D1Bitmap& bitmap{ *bitmapDrawInstruction.getBitmap() };
 		D2D1_SIZE_F originalSize = { sourceRectangle.width, sourceRectangle.height };
-
-		//only rotation or both rotation and scale
-		if (bitmapDrawInstruction.requiresRotation()) {
-			D2D1_POINT_2F d2dCenter{ center.x, center.y };
-			D2D1::Matrix3x2F transform = makeRotationMatrix(
-				bitmapDrawInstruction.getRotationDegrees(),
-				d2dCenter
-			);
-			//both rotation and scale
-			if (bitmapDrawInstruction.requiresScale()) {
-				transform = transform * makeScaleMatrix(
-					bitmapDrawInstruction.getScale(),
-					d2dCenter
-				);
-				float scaledWidth{
-					originalSize.width * bitmapDrawInstruction.getScale()
-				};
-				float scaledHeight{
-					originalSize.height * bitmapDrawInstruction.getScale()
-				};
-				const geometry::Point2& upperLeft{
-					center.x - (scaledWidth / 2),
-					center.y - (scaledHeight / 2)
-				};
-				makeTransformSubBitmapDrawCall(
-					bitmap,
-					transform,
-					upperLeft,
-					scaledWidth,
-					scaledHeight,
-					bitmapDrawInstruction.getOpacity(),
-					sourceRectangle
-				);
-			}
-			//only rotation
-			else {
-				const geometry::Point2& upperLeft{
-					center.x - (originalSize.width / 2),
-					center.y - (originalSize.height / 2)
-				};
-				makeTransformSubBitmapDrawCall(
-					bitmap,
-					transform,
-					upperLeft,
-					originalSize.width,
-					originalSize.height,
-					bitmapDrawInstruction.getOpacity(),
-					sourceRectangle
-				);
-			}
+		if (!isVisible(center, originalSize, bitmapDrawInstruction)) {
+			return;
 		}
-		//only scale
-		else if (bitmapDrawInstruction.requiresScale()) {
-			D2D1_POINT_2F d2dCenter{ center.x, center.y };
-			D2D1::Matrix3x2F transform = makeScaleMatrix(
-				bitmapDrawInstruction.getScale(),
-				d2dCenter
-			);
-			float scaledWidth{
-					originalSize.width * bitmapDrawInstruction.getScale()
-			};
-			float scaledHeight{
-				originalSize.height * bitmapDrawInstruction.getScale()
-			};
-			const geometry::Point2& upperLeft{
-				center.x - (scaledWidth / 2),
-				center.y - (scaledHeight / 2)
-			};
+
+		const geometry::Point2 upperLeft{
+			center.x - (originalSize.width / 2),
+			center.y - (originalSize.height / 2)
+		};
+		if (requiresTransform(bitmapDrawInstruction)) {
 			makeTransformSubBitmapDrawCall(
 				bitmap,
-				transform,
+				makeTransform(center, bitmapDrawInstruction),
 				upperLeft,
-				scaledWidth,
-				scaledHeight,
+				originalSize.width,
+				originalSize.height,
 				bitmapDrawInstruction.getOpacity(),
 				sourceRectangle
 			);
 		}
-		//normal draw call
 		else {
-			const geometry::Point2& upperLeft{
-				center.x - (originalSize.width / 2),
-				center.y - (originalSize.height / 2)
-			};
 			makeSubBitmapDrawCall(
 				bitmap,
 				upperLeft,
@@ -407,6 +342,126 @@ namespace wasp::window {
 		}
 	}
 
+	void WindowPainter::drawBitmapBatch(
+		const CComPtr<ID2D1Bitmap>& bitmap,
+		utility::Span<const graphics::SpriteInstance> instances
+	) {
+		//assume beginDraw has already been called
+		if (instances.empty()) {
+			return;
+		}
+		ID2D1Bitmap& bitmapReference{ *static_cast<ID2D1Bitmap*>(bitmap) };
+#ifdef WASP_D2D_SPRITE_BATCH
+		if (spriteBatchPointer) {
+			drawSpriteBatch(bitmapReference, instances);
+			return;
+		}
+#endif
+		drawSpriteLoop(bitmapReference, instances);
+	}
+
+	static D2D1::Matrix3x2F makeSpriteTransform(
+		const graphics::SpriteInstance& instance
+	) {
+		return makeTransform(instance.center, instance.rotationDegrees, instance.scale);
+	}
+
+	static D2D1_RECT_F makeSpriteDestination(
+		const graphics::SpriteInstance& instance,
+		const geometry::Rectangle& source
+	) {
+		//unscaled, the transform does the scaling
+		float halfWidth{ source.width / 2 };
+		float halfHeight{ source.height / 2 };
+		return D2D1::RectF(
+			instance.center.x - halfWidth,
+			instance.center.y - halfHeight,
+			instance.center.x + halfWidth,
+			instance.center.y + halfHeight
+		);
+	}
+
+	void WindowPainter::drawSpriteBatch(
+		ID2D1Bitmap& bitmap,
+		utility::Span<const graphics::SpriteInstance> instances
+	) {
+#ifdef WASP_D2D_SPRITE_BATCH
+		spriteDestinations.clear();
+		spriteSources.clear();
+		spriteColors.clear();
+		spriteTransforms.clear();
+		for (const graphics::SpriteInstance& instance : instances) {
+			if (!isVisible(instance)) {
+				continue;
+			}
+			//whole texels, as the loop below draws them
+			const geometry::Rectangle source{ instance.getPixelSourceRectangle() };
+			spriteDestinations.push_back(makeSpriteDestination(instance, source));
+			spriteSources.push_back(D2D1::RectU(
+				static_cast<UINT32>(source.x),
+				static_cast<UINT32>(source.y),
+				static_cast<UINT32>(source.x + source.width),
+				static_cast<UINT32>(source.y + source.height)
+			));
+			spriteColors.push_back(D2D1::ColorF(1.0f, 1.0f, 1.0f, instance.opacity));
+			spriteTransforms.push_back(makeSpriteTransform(instance));
+		}
+
+		if (spriteDestinations.empty()) {
+			return;
+		}
+
+		spriteBatchPointer->Clear();
+		HRESULT result{ spriteBatchPointer->AddSprites(
+			static_cast<UINT32>(spriteDestinations.size()),
+			spriteDestinations.data(),
+			spriteSources.data(),
+			spriteColors.data(),
+			spriteTransforms.data()
+		) };
+		if (FAILED(result)) {
+			throw HResultError{ "Error adding sprites to batch" };
+		}
+
+		//sprite batches can only be drawn aliased
+		D2D1_ANTIALIAS_MODE previousMode{ deviceContextPointer->GetAntialiasMode() };
+		deviceContextPointer->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+		deviceContextPointer->DrawSpriteBatch(
+			spriteBatchPointer,
+			&bitmap,
+			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR
+		);
+		deviceContextPointer->SetAntialiasMode(previousMode);
+#endif
+	}
+
+	void WindowPainter::drawSpriteLoop(
+		ID2D1Bitmap& bitmap,
+		utility::Span<const graphics::SpriteInstance> instances
+	) {
+		//one transform and one draw per sprite, identity is restored once at the end
+		for (const graphics::SpriteInstance& instance : instances) {
+			if (!isVisible(instance)) {
+				continue;
+			}
+			const geometry::Rectangle source{ instance.getPixelSourceRectangle() };
+			bufferRenderTargetPointer->SetTransform(makeSpriteTransform(instance));
+			bufferRenderTargetPointer->DrawBitmap(
+				&bitmap,
+				makeSpriteDestination(instance, source),
+				instance.opacity,
+				D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+				D2D1::RectF(
+					source.x,
+					source.y,
+					source.x + source.width,
+					source.y + source.height
+				)
+			);
+		}
+		bufferRenderTargetPointer->SetTransform(D2D1::Matrix3x2F::Identity());
+	}
+
 	void WindowPainter::drawText(
 		const geometry::Point2 pos,
 		const std::wstring& text,
@@ -424,8 +479,8 @@ namespace wasp::window {
 	inline void WindowPainter::makeBitmapDrawCall(
 		ID2D1Bitmap& bitmap,
 		const geometry::Point2 upperLeft,
-		float scaledWidth,
-		float scaledHeight,
+		float width,
+		float height,
 		float opacity
 	) {
 		bufferRenderTargetPointer->DrawBitmap(
@@ -433,8 +488,8 @@ namespace wasp::window {
 			D2D1::RectF(
 				upperLeft.x,
 				upperLeft.y,
-				upperLeft.x + scaledWidth,
-				upperLeft.y + scaledHeight),
+				upperLeft.x + width,
+				upperLeft.y + height),
 			opacity,
 			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR
 		);
@@ -444,20 +499,20 @@ namespace wasp::window {
 		ID2D1Bitmap& bitmap,
 		const D2D1::Matrix3x2F& transform,
 		const geometry::Point2 upperLeft,
-		float scaledWidth,
-		float scaledHeight,
+		float width,
+		float height,
 		float opacity
 	) {
 		bufferRenderTargetPointer->SetTransform(transform);
-		makeBitmapDrawCall(bitmap, upperLeft, scaledWidth, scaledHeight, opacity);
+		makeBitmapDrawCall(bitmap, upperLeft, width, height, opacity);
 		bufferRenderTargetPointer->SetTransform(D2D1::Matrix3x2F::Identity());
 	}
 
 	inline void WindowPainter::makeSubBitmapDrawCall(
 		ID2D1Bitmap& bitmap,
 		const geometry::Point2 upperLeft,
-		float scaledWidth,
-		float scaledHeight,
+		float width,
+		float height,
 		float opacity,
 		const geometry::Rectangle& sourceRectangle
 	) {
@@ -466,8 +521,8 @@ namespace wasp::window {
 			D2D1::RectF(
 				upperLeft.x,
 				upperLeft.y,
-				upperLeft.x + scaledWidth,
-				upperLeft.y + scaledHeight),
+				upperLeft.x + width,
+				upperLeft.y + height),
 			opacity, 
 			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
 			D2D1::RectF(
@@ -483,8 +538,8 @@ namespace wasp::window {
 		ID2D1Bitmap& bitmap,
 		const D2D1::Matrix3x2F& transform,
 		const geometry::Point2 upperLeft,
-		float scaledWidth,
-		float scaledHeight,
+		float width,
+		float height,
 		float opacity,
 		const geometry::Rectangle& sourceRectangle
 	) {
@@ -492,16 +547,48 @@ namespace wasp::window {
 		makeSubBitmapDrawCall(
 			bitmap, 
 			upperLeft, 
-			scaledWidth, 
-			scaledHeight,
+			width, 
+			height,
 			opacity,
 			sourceRectangle
 		);
 		bufferRenderTargetPointer->SetTransform(D2D1::Matrix3x2F::Identity());
 	}
 
+	inline bool WindowPainter::isVisible(
+		const geometry::Point2 center,
+		const D2D1_SIZE_F& size,
+		const graphics::BitmapDrawInstruction& bitmapDrawInstruction
+	) {
+		return viewportCuller.isVisible(
+			center,
+			size.width,
+			size.height,
+			bitmapDrawInstruction.getRotationDegrees(),
+			bitmapDrawInstruction.getScale()
+		);
+	}
+
+	inline bool WindowPainter::isVisible(const graphics::SpriteInstance& instance) {
+		return viewportCuller.isVisible(
+			instance.center,
+			instance.sourceRectangle.width,
+			instance.sourceRectangle.height,
+			instance.rotationDegrees,
+			instance.scale
+		);
+	}
+
 	void WindowPainter::endDraw() {
 		bufferRenderTargetPointer->EndDraw();
+		lastFrameDrawnCount.store(
+			viewportCuller.getDrawnCount(),
+			std::memory_order_relaxed
+		);
+		lastFrameCulledCount.store(
+			viewportCuller.getCulledCount(),
+			std::memory_order_relaxed
+		);
 	}
 
 
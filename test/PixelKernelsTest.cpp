@@ -0,0 +1,250 @@
+#include "PixelKernels.h"
+#include "SoftwareRasterizer.h"
+
+#include <vector>
+#include <random>
+#include <iostream>
+#include <cmath>
+
+//checks the contract in PixelKernels.h: every instruction set the cpu supports
+//gives exactly the scalar output on random spans, at every length and
+//alignment the vector loops and their tails can see
+//the rasterizer part only has to run clean, build it with sanitizers to check
+//it doesn't read or write outside its buffers
+//returns nonzero if anything failed
+
+namespace {
+	using namespace wasp::graphics;
+
+	constexpr int trials{ 4000 };
+	constexpr std::size_t maxSpanLength{ 80 };
+	constexpr std::size_t maxMisalignment{ 8 };	//in pixels
+	constexpr int imageWidth{ 97 };
+	constexpr int imageHeight{ 61 };
+	constexpr float pi{ 3.14159265f };
+
+	std::mt19937 random{ 12345 };
+
+	int failures{ 0 };
+
+	int randomInt(int min, int max) {
+		return std::uniform_int_distribution<int>{ min, max }(random);
+	}
+
+	float randomFloat(float min, float max) {
+		return std::uniform_real_distribution<float>{ min, max }(random);
+	}
+
+	//mostly valid premultiplied pixels, with extra fully opaque and fully
+	//transparent ones since the kernels have fast paths for them
+	uint32_t randomPremultiplied() {
+		const int choice{ randomInt(0, 7) };
+		const uint32_t alpha{
+			choice == 0 ? 0u : choice == 1 ? 255u : static_cast<uint32_t>(randomInt(0, 255))
+		};
+		uint32_t toRet{ alpha << 24 };
+		for (int channel{ 0 }; channel < 3; ++channel) {
+			toRet |= static_cast<uint32_t>(randomInt(0, static_cast<int>(alpha))) << (channel * 8);
+		}
+		return toRet;
+	}
+
+	//not premultiplied, blend has to saturate these the same way everywhere
+	uint32_t randomAny() {
+		return static_cast<uint32_t>(random());
+	}
+
+	void fillRandom(std::vector<uint32_t>& pixels, bool premultiplied) {
+		for (uint32_t& pixel : pixels) {
+			pixel = premultiplied ? randomPremultiplied() : randomAny();
+		}
+	}
+
+	void expectEqual(
+		const std::vector<uint32_t>& expected,
+		const std::vector<uint32_t>& actual,
+		pixel::InstructionSet instructionSet,
+		const char* kernelName,
+		std::size_t count,
+		std::size_t offset
+	) {
+		if (expected == actual) {
+			return;
+		}
+		for (std::size_t i{ 0 }; i < expected.size(); ++i) {
+			if (expected[i] != actual[i]) {
+				std::cout << "FAIL " << pixel::getName(instructionSet) << " " << kernelName
+					<< " count " << count << " offset " << offset << " pixel " << i
+					<< std::hex << " expected " << expected[i] << " got " << actual[i]
+					<< std::dec << "\n";
+				break;
+			}
+		}
+		++failures;
+	}
+
+	pixel::SourceImage makeRandomSourceImage(const std::vector<uint32_t>& image) {
+		const int left{ randomInt(0, 10) };
+		const int top{ randomInt(0, 10) };
+		return {
+			image.data(),
+			imageWidth,
+			left,
+			top,
+			randomInt(left, imageWidth),
+			randomInt(top, imageHeight)
+		};
+	}
+
+	//starts inside and outside the image, steps from heavy magnification to
+	//skipping several pixels at a time, in every direction
+	pixel::AffineSpan makeRandomSpan() {
+		const float radians{ randomFloat(0.0f, 2.0f * pi) };
+		const float scale{ randomFloat(0.2f, 4.0f) };
+		return {
+			pixel::toFixed(randomFloat(-20.0f, imageWidth + 20.0f)),
+			pixel::toFixed(randomFloat(-20.0f, imageHeight + 20.0f)),
+			pixel::toFixed(std::cos(radians) / scale),
+			pixel::toFixed(-std::sin(radians) / scale)
+		};
+	}
+
+	void testKernels(pixel::InstructionSet instructionSet) {
+		const pixel::Kernels& reference{ pixel::getKernels(pixel::InstructionSet::scalar) };
+		const pixel::Kernels& kernels{ pixel::getKernels(instructionSet) };
+
+		std::vector<uint32_t> image(imageWidth * imageHeight);
+		fillRandom(image, true);
+
+		const std::size_t bufferSize{ maxSpanLength + maxMisalignment };
+		std::vector<uint32_t> source(bufferSize);
+		std::vector<uint32_t> destination(bufferSize);
+		std::vector<uint32_t> expected{};
+		std::vector<uint32_t> actual{};
+
+		for (int trial{ 0 }; trial < trials; ++trial) {
+			const std::size_t count{ static_cast<std::size_t>(randomInt(0, maxSpanLength)) };
+			const std::size_t offset{ static_cast<std::size_t>(randomInt(0, maxMisalignment)) };
+			fillRandom(source, trial % 5 != 0);
+			fillRandom(destination, true);
+
+			const uint32_t color{ randomAny() };
+			expected = destination;
+			actual = destination;
+			reference.fill(expected.data() + offset, count, color);
+			kernels.fill(actual.data() + offset, count, color);
+			expectEqual(expected, actual, instructionSet, "fill", count, offset);
+
+			const uint32_t amount{ static_cast<uint32_t>(randomInt(0, 256)) };
+			expected = destination;
+			actual = destination;
+			reference.modulate(expected.data() + offset, source.data(), count, amount);
+			kernels.modulate(actual.data() + offset, source.data(), count, amount);
+			expectEqual(expected, actual, instructionSet, "modulate", count, offset);
+
+			expected = destination;
+			actual = destination;
+			reference.blend(expected.data() + offset, source.data(), count);
+			kernels.blend(actual.data() + offset, source.data(), count);
+			expectEqual(expected, actual, instructionSet, "blend", count, offset);
+
+			const pixel::SourceImage sourceImage{ makeRandomSourceImage(image) };
+			const pixel::AffineSpan span{ makeRandomSpan() };
+
+			expected = destination;
+			actual = destination;
+			reference.sampleNearest(expected.data() + offset, count, sourceImage, span);
+			kernels.sampleNearest(actual.data() + offset, count, sourceImage, span);
+			expectEqual(expected, actual, instructionSet, "sampleNearest", count, offset);
+
+			expected = destination;
+			actual = destination;
+			reference.sampleBilinear(expected.data() + offset, count, sourceImage, span);
+			kernels.sampleBilinear(actual.data() + offset, count, sourceImage, span);
+			expectEqual(expected, actual, instructionSet, "sampleBilinear", count, offset);
+		}
+	}
+
+	//an opaque unrotated draw at whole pixel positions is a plain copy
+	void testRasterizerCopy() {
+		SoftwareBitmap bitmap{ 16, 12 };
+		bitmap.pixels.resize(bitmap.width * bitmap.height);
+		for (uint32_t& pixel : bitmap.pixels) {
+			pixel = SoftwareRasterizer::makeOpaqueColor(static_cast<int>(randomAny()));
+		}
+
+		SoftwareRasterizer rasterizer{ 40, 30 };
+		rasterizer.clear(0xFF000000u);
+		rasterizer.drawBitmap(
+			bitmap,
+			{ 10.0f + bitmap.width / 2.0f, 5.0f + bitmap.height / 2.0f },
+			{ 0.0f, 0.0f, static_cast<float>(bitmap.width), static_cast<float>(bitmap.height) },
+			0.0f,
+			1.0f,
+			1.0f
+		);
+
+		for (int y{ 0 }; y < bitmap.height; ++y) {
+			for (int x{ 0 }; x < bitmap.width; ++x) {
+				const uint32_t actual{ rasterizer.getPixels()[(y + 5) * rasterizer.getWidth() + x + 10] };
+				if (actual != bitmap.pixels[y * bitmap.width + x]) {
+					std::cout << "FAIL rasterizer copy at " << x << ", " << y << "\n";
+					++failures;
+					return;
+				}
+			}
+		}
+	}
+
+	//draws that straddle and leave the framebuffer, with source rectangles
+	//that run past the bitmap; nothing to compare, sanitizers do the checking
+	void testRasterizerBounds() {
+		SoftwareBitmap bitmap{ 23, 17 };
+		bitmap.pixels.resize(bitmap.width * bitmap.height);
+		for (uint32_t& pixel : bitmap.pixels) {
+			pixel = randomPremultiplied();
+		}
+
+		SoftwareRasterizer rasterizer{ 64, 48 };
+		rasterizer.clear(0xFF202020u);
+		for (int trial{ 0 }; trial < trials; ++trial) {
+			const float sourceX{ randomFloat(-4.0f, bitmap.width + 4.0f) };
+			const float sourceY{ randomFloat(-4.0f, bitmap.height + 4.0f) };
+			rasterizer.drawBitmap(
+				bitmap,
+				{ randomFloat(-40.0f, 104.0f), randomFloat(-40.0f, 88.0f) },
+				{ sourceX, sourceY, randomFloat(0.0f, 30.0f), randomFloat(0.0f, 30.0f) },
+				trial % 3 == 0 ? 0.0f : randomFloat(-720.0f, 720.0f),
+				trial % 4 == 0 ? 1.0f : randomFloat(0.05f, 6.0f),
+				randomFloat(0.0f, 1.0f)
+			);
+		}
+		rasterizer.drawText(
+			{ -3.0f, 40.0f },
+			L"clipped text \u00e9\u4e2d and a line long enough to wrap",
+			{ 80.0f, 20.0f },
+			0xFFFFFFFFu
+		);
+	}
+}
+
+int main() {
+	std::cout << "best pixel kernels " << pixel::getName(pixel::getBestInstructionSet()) << "\n";
+	for (pixel::InstructionSet instructionSet : { pixel::InstructionSet::sse2, pixel::InstructionSet::avx2 }) {
+		if (!pixel::isSupported(instructionSet)) {
+			std::cout << "skipped " << pixel::getName(instructionSet) << ", not supported\n";
+			continue;
+		}
+		testKernels(instructionSet);
+		std::cout << "checked " << pixel::getName(instructionSet) << " against scalar\n";
+	}
+	testRasterizerCopy();
+	testRasterizerBounds();
+
+	if (failures > 0) {
+		std::cout << failures << " failures\n";
+		return 1;
+	}
+	std::cout << "pixel kernels ok\n";
+	return 0;
+}
\ No newline at end of file
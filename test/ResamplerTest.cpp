@@ -0,0 +1,164 @@
+#include "Resampler.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+//quality checks for the resampler at the rate pairs the mixer sees
+//a sine sweep through the passband has to come out matching the ideal
+//resampled sweep, a tone above the output nyquist has to be filtered out,
+//and how input is split across push and pull must not change the output
+//returns nonzero if anything failed
+
+namespace {
+	using namespace wasp::sound;
+
+	constexpr double pi{ 3.14159265358979323846 };
+	constexpr double sweepSeconds{ 2.0 };
+	constexpr double sweepStartFrequency{ 20.0 };
+	//of the lower rate, inside the passband
+	constexpr double sweepEndFraction{ 0.4 };
+	constexpr double amplitude{ 0.5 };
+	constexpr double minimumSignalToNoise{ 60.0 };	//db
+	//db, lower since the 48000 -> 44100 tone sits close to the cutoff
+	constexpr double minimumStopbandAttenuation{ 50.0 };
+	constexpr std::size_t chunkFrames{ 512 };
+
+	struct RatePair {
+		uint32_t inputRate{};
+		uint32_t outputRate{};
+	};
+
+	constexpr RatePair ratePairs[]{
+		{ 44100, 48000 },
+		{ 22050, 48000 },
+		{ 32000, 44100 },
+		{ 48000, 44100 },
+		{ 48000, 22050 }
+	};
+
+	int failures{ 0 };
+
+	//linear sweep, so the reference can be evaluated at any time
+	double sweepPhase(double seconds, double endFrequency) {
+		const double rate{ (endFrequency - sweepStartFrequency) / sweepSeconds };
+		return 2.0 * pi * (sweepStartFrequency * seconds + 0.5 * rate * seconds * seconds);
+	}
+
+	std::vector<float> resample(
+		const RatePair& ratePair,
+		const std::vector<float>& input,
+		std::size_t pushFrames,
+		std::size_t pullFrames
+	) {
+		Resampler resampler{ ratePair.inputRate, ratePair.outputRate, 1 };
+		std::vector<float> output{};
+		std::vector<float> pulled(pullFrames);
+		for (std::size_t i{ 0 }; i < input.size(); i += pushFrames) {
+			resampler.push(input.data() + i, std::min(pushFrames, input.size() - i));
+			std::size_t framesPulled{};
+			while ((framesPulled = resampler.pull(pulled.data(), pullFrames)) > 0) {
+				output.insert(output.end(), pulled.begin(), pulled.begin() + framesPulled);
+			}
+		}
+		return output;
+	}
+
+	void testSweep(const RatePair& ratePair) {
+		const double endFrequency{
+			sweepEndFraction * std::min(ratePair.inputRate, ratePair.outputRate)
+		};
+		std::vector<float> input(static_cast<std::size_t>(sweepSeconds * ratePair.inputRate));
+		for (std::size_t i{ 0 }; i < input.size(); ++i) {
+			input[i] = static_cast<float>(
+				amplitude * std::sin(sweepPhase(static_cast<double>(i) / ratePair.inputRate, endFrequency))
+			);
+		}
+		const std::vector<float> output{ resample(ratePair, input, chunkFrames, chunkFrames) };
+
+		const double latencySeconds{
+			Resampler{ ratePair.inputRate, ratePair.outputRate, 1 }.getLatencyFrames()
+				/ ratePair.inputRate
+		};
+		//skip the filter warming up and running out at either end
+		const std::size_t margin{ ratePair.outputRate / 10 };
+		double signal{ 0.0 };
+		double noise{ 0.0 };
+		for (std::size_t i{ margin }; i + margin < output.size(); ++i) {
+			const double seconds{ static_cast<double>(i) / ratePair.outputRate - latencySeconds };
+			const double expected{ amplitude * std::sin(sweepPhase(seconds, endFrequency)) };
+			signal += expected * expected;
+			noise += (output[i] - expected) * (output[i] - expected);
+		}
+		const double signalToNoise{ 10.0 * std::log10(signal / noise) };
+		std::cout << ratePair.inputRate << " -> " << ratePair.outputRate
+			<< " sweep snr " << signalToNoise << " db\n";
+		if (!(signalToNoise >= minimumSignalToNoise)) {
+			std::cout << "FAIL sweep snr below " << minimumSignalToNoise << " db\n";
+			++failures;
+		}
+	}
+
+	//only when going down, otherwise there is nothing above the output nyquist
+	void testStopband(const RatePair& ratePair) {
+		if (ratePair.outputRate >= ratePair.inputRate) {
+			return;
+		}
+		//halfway between the output nyquist and the input nyquist
+		const double frequency{ (ratePair.outputRate + ratePair.inputRate) / 4.0 };
+		std::vector<float> input(ratePair.inputRate);
+		for (std::size_t i{ 0 }; i < input.size(); ++i) {
+			input[i] = static_cast<float>(
+				amplitude * std::sin(2.0 * pi * frequency * i / ratePair.inputRate)
+			);
+		}
+		const std::vector<float> output{ resample(ratePair, input, chunkFrames, chunkFrames) };
+
+		const std::size_t margin{ ratePair.outputRate / 10 };
+		double inputPower{ amplitude * amplitude / 2.0 };
+		double outputPower{ 0.0 };
+		std::size_t counted{ 0 };
+		for (std::size_t i{ margin }; i + margin < output.size(); ++i, ++counted) {
+			outputPower += static_cast<double>(output[i]) * output[i];
+		}
+		outputPower /= std::max<std::size_t>(counted, 1);
+		const double attenuation{ 10.0 * std::log10(inputPower / outputPower) };
+		std::cout << ratePair.inputRate << " -> " << ratePair.outputRate << " "
+			<< frequency << " hz attenuated " << attenuation << " db\n";
+		if (!(attenuation >= minimumStopbandAttenuation)) {
+			std::cout << "FAIL stopband attenuation below " << minimumStopbandAttenuation << " db\n";
+			++failures;
+		}
+	}
+
+	//odd sizes so pushes and pulls land everywhere relative to compaction
+	void testChunking(const RatePair& ratePair) {
+		std::vector<float> input(ratePair.inputRate / 2);
+		for (std::size_t i{ 0 }; i < input.size(); ++i) {
+			input[i] = static_cast<float>(amplitude * std::sin(0.01 * i * i / input.size()));
+		}
+		const std::vector<float> expected{ resample(ratePair, input, input.size(), input.size() * 2) };
+		const std::vector<float> actual{ resample(ratePair, input, 37, 101) };
+		if (expected != actual) {
+			std::cout << "FAIL " << ratePair.inputRate << " -> " << ratePair.outputRate
+				<< " output depends on chunk sizes\n";
+			++failures;
+		}
+	}
+}
+
+int main() {
+	for (const RatePair& ratePair : ratePairs) {
+		testSweep(ratePair);
+		testStopband(ratePair);
+		testChunking(ratePair);
+	}
+
+	if (failures > 0) {
+		std::cout << failures << " failures\n";
+		return 1;
+	}
+	std::cout << "resampler ok\n";
+	return 0;
+}
\ No newline at end of file
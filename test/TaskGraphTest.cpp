@@ -0,0 +1,224 @@
+#include "TaskGraph.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+
+//the dependency rules in TaskGraph::build(): readers wait for the last
+//writer, writers wait for the readers since it, and a task that reads and
+//writes the same resource doesn't wait on itself
+//then run on a job system: independent tasks overlap, random graphs give the
+//same result as running the tasks in add order, and the critical path follows
+//known task sleeps
+//returns nonzero if anything failed
+
+namespace {
+	using namespace wasp::jobs;
+
+	constexpr std::size_t workerCount{ 3 };
+	constexpr std::chrono::milliseconds overlapSleep{ 40 };
+	constexpr int randomGraphs{ 200 };
+	constexpr int randomGraphTasks{ 24 };
+	constexpr int randomGraphResources{ 5 };
+
+	int failures{ 0 };
+
+	void expect(bool condition, const std::string& message) {
+		if (!condition) {
+			std::cout << "FAIL " << message << "\n";
+			++failures;
+		}
+	}
+
+	bool dependsOn(const TaskGraph& graph, TaskId task, TaskId predecessor) {
+		const std::vector<TaskId>& predecessors{ graph.getPredecessors(task) };
+		return std::find(predecessors.begin(), predecessors.end(), predecessor)
+			!= predecessors.end();
+	}
+
+	void doNothing() {}
+
+	void testReaderAfterWriter() {
+		TaskGraph graph{};
+		const TaskId writer{ graph.addTask("writer", {}, { "x" }, doNothing) };
+		const TaskId reader{ graph.addTask("reader", { "x" }, {}, doNothing) };
+		const TaskId unrelated{ graph.addTask("unrelated", { "y" }, {}, doNothing) };
+		graph.build();
+		expect(dependsOn(graph, reader, writer), "reader doesn't wait for the writer");
+		expect(graph.getPredecessors(writer).empty(), "first writer has predecessors");
+		expect(graph.getPredecessors(unrelated).empty(), "reader of another resource waits");
+	}
+
+	void testWriterAfterReaders() {
+		TaskGraph graph{};
+		const TaskId firstWriter{ graph.addTask("firstWriter", {}, { "x" }, doNothing) };
+		const TaskId firstReader{ graph.addTask("firstReader", { "x" }, {}, doNothing) };
+		const TaskId secondReader{ graph.addTask("secondReader", { "x" }, {}, doNothing) };
+		const TaskId secondWriter{ graph.addTask("secondWriter", {}, { "x" }, doNothing) };
+		const TaskId lateReader{ graph.addTask("lateReader", { "x" }, {}, doNothing) };
+		graph.build();
+		expect(dependsOn(graph, secondWriter, firstWriter), "writer doesn't wait for the last writer");
+		expect(dependsOn(graph, secondWriter, firstReader), "writer doesn't wait for the first reader");
+		expect(dependsOn(graph, secondWriter, secondReader), "writer doesn't wait for the second reader");
+		expect(!dependsOn(graph, secondReader, firstReader), "readers wait on each other");
+		expect(dependsOn(graph, lateReader, secondWriter), "reader doesn't wait for the newest writer");
+		expect(!dependsOn(graph, lateReader, firstReader), "reader waits on readers of an older write");
+	}
+
+	void testReadWriteTask() {
+		TaskGraph graph{};
+		const TaskId first{ graph.addTask("first", { "x" }, { "x" }, doNothing) };
+		const TaskId second{ graph.addTask("second", { "x" }, { "x" }, doNothing) };
+		graph.build();
+		expect(graph.getPredecessors(first).empty(), "read-write task depends on itself");
+		expect(!dependsOn(graph, second, second), "second read-write task depends on itself");
+		expect(dependsOn(graph, second, first), "read-write tasks don't chain");
+
+		//would never start if it waited on itself
+		JobSystem jobSystem{ workerCount };
+		graph.run(jobSystem);
+	}
+
+	//sleeping tasks overlap on a job system even on a single core
+	void testIndependentTasksOverlap() {
+		std::atomic<int> running{ 0 };
+		std::atomic<int> mostRunning{ 0 };
+		const auto sleepingTask{ [&] {
+			const int nowRunning{ ++running };
+			int previous{ mostRunning.load() };
+			while (nowRunning > previous && !mostRunning.compare_exchange_weak(previous, nowRunning));
+			std::this_thread::sleep_for(overlapSleep);
+			--running;
+		} };
+
+		TaskGraph graph{};
+		for (std::size_t i{ 0 }; i <= workerCount; ++i) {
+			const std::string name{ "task" + std::to_string(i) };
+			graph.addTask(name, {}, { name }, sleepingTask);
+		}
+		JobSystem jobSystem{ workerCount };
+		const auto start{ std::chrono::steady_clock::now() };
+		graph.run(jobSystem);
+		const auto elapsed{ std::chrono::steady_clock::now() - start };
+
+		std::cout << "independent tasks: " << mostRunning.load() << " at once, "
+			<< std::chrono::duration<double, std::milli>{ elapsed }.count() << " ms\n";
+		expect(mostRunning.load() == static_cast<int>(workerCount + 1), "independent tasks didn't all overlap");
+		expect(elapsed < overlapSleep * (workerCount + 1), "independent tasks took as long as running in turn");
+	}
+
+	//every task mixes what it reads into what it writes, so any task running
+	//out of order or at the same time as a conflicting one changes the result
+	void testRandomGraphsMatchAddOrder() {
+		std::mt19937 random{ 12345 };
+		JobSystem jobSystem{ workerCount };
+		for (int graphIndex{ 0 }; graphIndex < randomGraphs; ++graphIndex) {
+			struct TaskAccess {
+				std::vector<int> reads{};
+				std::vector<int> writes{};
+			};
+			std::vector<TaskAccess> accesses(randomGraphTasks);
+			for (TaskAccess& access : accesses) {
+				for (int resource{ 0 }; resource < randomGraphResources; ++resource) {
+					const unsigned int choice{ static_cast<unsigned int>(random() % 6) };
+					if (choice == 0 || choice == 2) {
+						access.reads.push_back(resource);
+					}
+					if (choice == 1 || choice == 2) {
+						access.writes.push_back(resource);
+					}
+				}
+			}
+
+			const auto makeFunction{ [&](std::vector<uint64_t>& values, int taskIndex) {
+				return [&values, &access = accesses[taskIndex], taskIndex] {
+					uint64_t mixed{ static_cast<uint64_t>(taskIndex) + 1 };
+					for (int resource : access.reads) {
+						mixed = mixed * 1'000'003 + values[resource];
+					}
+					for (int resource : access.writes) {
+						values[resource] = values[resource] * 31 + mixed;
+					}
+					//gives other jobs a chance to run in between
+					std::this_thread::yield();
+				};
+			} };
+
+			std::vector<uint64_t> expected(randomGraphResources);
+			for (int taskIndex{ 0 }; taskIndex < randomGraphTasks; ++taskIndex) {
+				makeFunction(expected, taskIndex)();
+			}
+
+			std::vector<uint64_t> actual(randomGraphResources);
+			TaskGraph graph{};
+			for (int taskIndex{ 0 }; taskIndex < randomGraphTasks; ++taskIndex) {
+				std::vector<std::string> reads{};
+				std::vector<std::string> writes{};
+				for (int resource : accesses[taskIndex].reads) {
+					reads.push_back(std::to_string(resource));
+				}
+				for (int resource : accesses[taskIndex].writes) {
+					writes.push_back(std::to_string(resource));
+				}
+				graph.addTask(
+					"task" + std::to_string(taskIndex),
+					reads,
+					writes,
+					makeFunction(actual, taskIndex)
+				);
+			}
+			graph.run(jobSystem);
+			if (actual != expected) {
+				std::cout << "FAIL random graph " << graphIndex << " differs from add order\n";
+				++failures;
+				return;
+			}
+		}
+	}
+
+	//a 20ms -> 30ms chain beside a lone 10ms task
+	void testCriticalPath() {
+		const auto sleepFor{ [](int milliseconds) {
+			return [milliseconds] {
+				std::this_thread::sleep_for(std::chrono::milliseconds{ milliseconds });
+			};
+		} };
+		TaskGraph graph{};
+		const TaskId produce{ graph.addTask("produce", {}, { "x" }, sleepFor(20)) };
+		graph.addTask("lone", {}, { "y" }, sleepFor(10));
+		const TaskId consume{ graph.addTask("consume", { "x" }, { "z" }, sleepFor(30)) };
+		JobSystem jobSystem{ workerCount };
+		graph.run(jobSystem);
+
+		const CriticalPath& path{ graph.getCriticalPath() };
+		std::cout << "critical path: " << graph.formatCriticalPath() << "\n";
+		expect(
+			path.tasks == std::vector<TaskId>{ produce, consume },
+			"critical path isn't produce -> consume"
+		);
+		//sleeps only ever overshoot, allow plenty for a loaded machine
+		expect(path.seconds >= 0.050, "critical path shorter than its sleeps");
+		expect(path.seconds < 0.100, "critical path much longer than its sleeps");
+	}
+}
+
+int main() {
+	testReaderAfterWriter();
+	testWriterAfterReaders();
+	testReadWriteTask();
+	testIndependentTasksOverlap();
+	testRandomGraphsMatchAddOrder();
+	testCriticalPath();
+
+	if (failures > 0) {
+		std::cout << failures << " failures\n";
+		return 1;
+	}
+	std::cout << "task graph ok\n";
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "TextureAtlas.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+//checks the skyline packer and atlas builder on random sizes
+//packed rectangles have to stay inside the page and never overlap, a failed
+//insert must leave the packer as it was, every image has to land on its page
+//pixel for pixel with its padding repeating its edge, and images too big for
+//a page have to be left unpacked
+//returns nonzero if anything failed
+
+namespace {
+	using namespace wasp::graphics;
+
+	constexpr int packerSize{ 256 };
+	constexpr int packerTrials{ 200 };
+	constexpr int pageSize{ 512 };
+	constexpr int imageCount{ 300 };
+	constexpr int paddings[]{ 0, 1, 3 };
+
+	std::mt19937 random{ 12345 };
+
+	int failures{ 0 };
+
+	void expect(bool condition, const std::string& message) {
+		if (!condition) {
+			std::cout << "FAIL " << message << "\n";
+			++failures;
+		}
+	}
+
+	int randomInt(int min, int max) {
+		return std::uniform_int_distribution<int>{ min, max }(random);
+	}
+
+	struct Box {
+		int x{};
+		int y{};
+		int width{};
+		int height{};
+	};
+
+	bool overlaps(const Box& a, const Box& b) {
+		return a.x < b.x + b.width && b.x < a.x + a.width
+			&& a.y < b.y + b.height && b.y < a.y + a.height;
+	}
+
+	//returns the index of a box overlapping an earlier one, or -1
+	int findOverlap(const std::vector<Box>& boxes) {
+		for (std::size_t i{ 0 }; i < boxes.size(); ++i) {
+			for (std::size_t j{ 0 }; j < i; ++j) {
+				if (overlaps(boxes[i], boxes[j])) {
+					return static_cast<int>(i);
+				}
+			}
+		}
+		return -1;
+	}
+
+	//fills until inserts start failing, then checks a failed insert changed
+	//nothing by running the same inserts on a copy that never saw it
+	void testPacker() {
+		for (int trial{ 0 }; trial < packerTrials; ++trial) {
+			SkylinePacker packer{ packerSize, packerSize };
+			std::vector<Box> boxes{};
+			int usedHeight{ 0 };
+			bool failed{ false };
+			while (!failed) {
+				Box box{ 0, 0, randomInt(1, packerSize / 4), randomInt(1, packerSize / 4) };
+				const SkylinePacker beforeInsert{ packer };
+				if (packer.insert(box.width, box.height, box.x, box.y)) {
+					expect(
+						box.x >= 0 && box.y >= 0
+							&& box.x + box.width <= packerSize
+							&& box.y + box.height <= packerSize,
+						"packed rectangle outside the packer"
+					);
+					boxes.push_back(box);
+					usedHeight = std::max(usedHeight, box.y + box.height);
+					continue;
+				}
+				failed = true;
+
+				SkylinePacker untouched{ beforeInsert };
+				for (int i{ 0 }; i < 20; ++i) {
+					const int width{ randomInt(1, 16) };
+					const int height{ randomInt(1, 16) };
+					Box afterFailure{ 0, 0, width, height };
+					Box withoutFailure{ 0, 0, width, height };
+					const bool fitAfterFailure{
+						packer.insert(width, height, afterFailure.x, afterFailure.y)
+					};
+					const bool fitWithoutFailure{
+						untouched.insert(width, height, withoutFailure.x, withoutFailure.y)
+					};
+					if (fitAfterFailure != fitWithoutFailure
+						|| afterFailure.x != withoutFailure.x
+						|| afterFailure.y != withoutFailure.y
+					) {
+						std::cout << "FAIL failed insert changed the packer\n";
+						++failures;
+						return;
+					}
+				}
+			}
+			const int overlap{ findOverlap(boxes) };
+			if (overlap >= 0) {
+				std::cout << "FAIL packer trial " << trial << " rectangle " << overlap << " overlaps\n";
+				++failures;
+				return;
+			}
+			expect(packer.getUsedHeight() >= usedHeight, "used height below a packed rectangle");
+		}
+
+		SkylinePacker packer{ packerSize, packerSize };
+		int x{};
+		int y{};
+		expect(!packer.insert(packerSize + 1, 1, x, y), "packed a rectangle wider than the packer");
+		expect(!packer.insert(1, packerSize + 1, x, y), "packed a rectangle taller than the packer");
+		expect(packer.insert(packerSize, packerSize, x, y), "full size rectangle didn't fit");
+		expect(!packer.insert(1, 1, x, y), "packed into a full packer");
+	}
+
+	//every pixel unique to its image and position, so a copy from the wrong
+	//place can't match by accident
+	SoftwareBitmap makeImage(int index, int width, int height) {
+		SoftwareBitmap image{
+			width,
+			height,
+			std::vector<uint32_t>(static_cast<std::size_t>(width) * height)
+		};
+		for (int y{ 0 }; y < height; ++y) {
+			for (int x{ 0 }; x < width; ++x) {
+				image.pixels[static_cast<std::size_t>(y) * width + x] = static_cast<uint32_t>(
+					(index + 1) << 20 | y << 10 | x
+				);
+			}
+		}
+		return image;
+	}
+
+	uint32_t getPixel(const SoftwareBitmap& bitmap, int x, int y) {
+		return bitmap.pixels[static_cast<std::size_t>(y) * bitmap.width + x];
+	}
+
+	//the padded area in the page has to be the image with its edges repeated
+	bool matchesWithPadding(
+		const SoftwareBitmap& image,
+		const SoftwareBitmap& page,
+		const Box& imageBox,
+		int padding
+	) {
+		for (int y{ -padding }; y < image.height + padding; ++y) {
+			for (int x{ -padding }; x < image.width + padding; ++x) {
+				const uint32_t expected{ getPixel(
+					image,
+					std::clamp(x, 0, image.width - 1),
+					std::clamp(y, 0, image.height - 1)
+				) };
+				if (getPixel(page, imageBox.x + x, imageBox.y + y) != expected) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void testBuilder(int padding) {
+		std::vector<SoftwareBitmap> images{};
+		for (int i{ 0 }; i < imageCount; ++i) {
+			images.push_back(makeImage(i, randomInt(1, 96), randomInt(1, 96)));
+		}
+		//too big once padded, too big outright, and empty
+		const std::size_t firstOversize{ images.size() };
+		images.push_back(makeImage(imageCount, pageSize - padding * 2 + 1, 4));
+		images.push_back(makeImage(imageCount + 1, 4, pageSize + 1));
+		images.push_back(makeImage(imageCount + 2, 0, 0));
+		//exactly fits a page once padded
+		const std::size_t fullPage{ images.size() };
+		images.push_back(makeImage(imageCount + 3, pageSize - padding * 2, pageSize - padding * 2));
+
+		TextureAtlasBuilder builder{ pageSize, padding };
+		const std::vector<AtlasPlacement> placements{ builder.build(images) };
+		const std::vector<SoftwareBitmap>& pages{ builder.getPages() };
+		const std::string withPadding{ " with padding " + std::to_string(padding) };
+
+		expect(placements.size() == images.size(), "placement count differs" + withPadding);
+		for (std::size_t i{ firstOversize }; i < fullPage; ++i) {
+			expect(
+				placements[i].page == AtlasPlacement::notPacked,
+				"image " + std::to_string(i) + " packed but doesn't fit" + withPadding
+			);
+		}
+		expect(placements[fullPage].page != AtlasPlacement::notPacked, "page sized image not packed" + withPadding);
+
+		std::vector<std::vector<Box>> paddedBoxes(pages.size());
+		for (std::size_t i{ 0 }; i < images.size(); ++i) {
+			const AtlasPlacement& placement{ placements[i] };
+			if (i < firstOversize) {
+				expect(placement.page != AtlasPlacement::notPacked, "image that fits not packed" + withPadding);
+			}
+			if (placement.page == AtlasPlacement::notPacked) {
+				continue;
+			}
+			const SoftwareBitmap& image{ images[i] };
+			const SoftwareBitmap& page{ pages[placement.page] };
+			const Box imageBox{
+				static_cast<int>(placement.rectangle.x),
+				static_cast<int>(placement.rectangle.y),
+				static_cast<int>(placement.rectangle.width),
+				static_cast<int>(placement.rectangle.height)
+			};
+			const Box paddedBox{
+				imageBox.x - padding,
+				imageBox.y - padding,
+				image.width + padding * 2,
+				image.height + padding * 2
+			};
+			if (imageBox.width != image.width || imageBox.height != image.height
+				|| paddedBox.x < 0 || paddedBox.y < 0
+				|| paddedBox.x + paddedBox.width > page.width
+				|| paddedBox.y + paddedBox.height > page.height
+			) {
+				std::cout << "FAIL image " << i << " placed outside its page" << withPadding << "\n";
+				++failures;
+				return;
+			}
+			expect(
+				matchesWithPadding(image, page, imageBox, padding),
+				"image " + std::to_string(i) + " pixels or padding wrong" + withPadding
+			);
+			paddedBoxes[placement.page].push_back(paddedBox);
+		}
+
+		for (std::size_t page{ 0 }; page < pages.size(); ++page) {
+			expect(findOverlap(paddedBoxes[page]) < 0, "padded images overlap" + withPadding);
+			expect(pages[page].width == pageSize, "page narrower than the page size" + withPadding);
+			int usedHeight{ 0 };
+			for (const Box& box : paddedBoxes[page]) {
+				usedHeight = std::max(usedHeight, box.y + box.height);
+			}
+			const int expectedHeight{ page + 1 == pages.size() ? usedHeight : pageSize };
+			expect(pages[page].height == expectedHeight, "page height wrong" + withPadding);
+			expect(
+				pages[page].pixels.size() == static_cast<std::size_t>(pages[page].width) * pages[page].height,
+				"page pixel count differs from its size" + withPadding
+			);
+		}
+
+		const double efficiency{ builder.getEfficiency() };
+		std::cout << "padding " << padding << ": " << pages.size() << " pages, "
+			<< efficiency * 100.0 << "% efficient\n";
+		expect(efficiency > 0.0 && efficiency <= 1.0, "efficiency out of range" + withPadding);
+	}
+}
+
+int main() {
+	testPacker();
+	for (int padding : paddings) {
+		testBuilder(padding);
+	}
+	TextureAtlasBuilder emptyBuilder{ pageSize, 1 };
+	expect(emptyBuilder.build({}).empty(), "placements for no images");
+	expect(emptyBuilder.getPages().empty(), "pages for no images");
+
+	if (failures > 0) {
+		std::cout << failures << " failures\n";
+		return 1;
+	}
+	std::cout << "texture atlas ok\n";
+	return 0;
+}
\ No newline at end of file
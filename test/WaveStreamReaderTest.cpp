@@ -0,0 +1,188 @@
+#include "WaveStreamReader.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <iostream>
+
+//streams wave files written to the temp directory
+//a consumer pulling at playback speed from a small buffer must never underrun
+//and must get the file's data back byte for byte, headers that would break
+//the buffer sizing must be rejected, and truncated files must neither stall
+//nor hang
+//returns nonzero if anything failed
+
+namespace {
+	using namespace wasp::sound;
+	using clockType = std::chrono::steady_clock;
+
+	constexpr uint32_t sampleRate{ 8000 };
+	constexpr uint16_t channels{ 1 };
+	constexpr uint16_t bytesPerSample{ 2 };
+	constexpr uint16_t blockAlign{ channels * bytesPerSample };
+	constexpr uint32_t bytesPerSecond{ sampleRate * blockAlign };
+
+	int failures{ 0 };
+
+	void expect(bool condition, const std::string& message) {
+		if (!condition) {
+			std::cout << "FAIL " << message << "\n";
+			++failures;
+		}
+	}
+
+	std::filesystem::path getTempPath(const std::string& fileName) {
+		return std::filesystem::temp_directory_path() / ("wasp_" + fileName);
+	}
+
+	//16 bit mono pcm; claimedDataSize is what the header says, data is what
+	//actually follows it
+	std::filesystem::path writeWaveFile(
+		const std::string& fileName,
+		const std::vector<std::byte>& data,
+		uint32_t claimedDataSize,
+		uint32_t averageBytesPerSecond = bytesPerSecond
+	) {
+		const std::filesystem::path path{ getTempPath(fileName) };
+		std::ofstream outStream{ path, std::ios::binary };
+		const auto writeBytes{ [&](const void* bytes, std::size_t count) {
+			outStream.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+		} };
+		const auto write32{ [&](uint32_t value) { writeBytes(&value, sizeof(value)); } };
+		const auto write16{ [&](uint16_t value) { writeBytes(&value, sizeof(value)); } };
+
+		writeBytes("RIFF", 4);
+		write32(36 + claimedDataSize);
+		writeBytes("WAVE", 4);
+		writeBytes("fmt ", 4);
+		write32(16);
+		write16(wave::constants::formatPCM);
+		write16(channels);
+		write32(sampleRate);
+		write32(averageBytesPerSecond);
+		write16(blockAlign);
+		write16(bytesPerSample * 8);
+		writeBytes("data", 4);
+		write32(claimedDataSize);
+		writeBytes(data.data(), data.size());
+		return path;
+	}
+
+	std::vector<std::byte> makeData(std::size_t byteCount) {
+		std::vector<std::byte> toRet(byteCount);
+		for (std::size_t i{ 0 }; i < byteCount; ++i) {
+			toRet[i] = static_cast<std::byte>((i * 7 + i / 256) & 0xFF);
+		}
+		return toRet;
+	}
+
+	//a quarter second buffer drained in 10ms blocks at playback speed, the way
+	//the mixer reads it; the fill thread has to keep up the whole time
+	void testPlaybackSpeedConsumer() {
+		const std::vector<std::byte> data{ makeData(bytesPerSecond * 3 / 2) };
+		const std::filesystem::path path{
+			writeWaveFile("stream.wav", data, static_cast<uint32_t>(data.size()))
+		};
+
+		constexpr std::size_t blockBytes{ bytesPerSecond / 100 };
+		constexpr std::chrono::milliseconds blockDuration{ 10 };
+		std::vector<std::byte> received{};
+		std::vector<std::byte> block(blockBytes);
+		{
+			WaveStreamReader reader{ path.wstring(), false, 0.25, 1024 };
+			reader.start();
+			clockType::time_point nextRead{ clockType::now() };
+			while (!reader.isFinished()) {
+				std::this_thread::sleep_until(nextRead);
+				nextRead += blockDuration;
+				const std::size_t bytesRead{ reader.read(block.data(), block.size()) };
+				received.insert(received.end(), block.begin(), block.begin() + bytesRead);
+			}
+			const StreamStatistics statistics{ reader.getStatistics() };
+			std::cout << "playback speed: " << statistics.chunkReads << " chunk reads, minimum fill "
+				<< statistics.minimumBufferFill << " of " << statistics.bufferCapacity
+				<< ", slowest read " << statistics.slowestReadMicroseconds << " us\n";
+			expect(statistics.underruns == 0, "underruns while reading at playback speed");
+			expect(statistics.underrunBytes == 0, "underrun bytes while reading at playback speed");
+			expect(statistics.bytesStreamed == data.size(), "not every byte was streamed");
+		}
+		expect(received == data, "streamed data differs from the file");
+		std::filesystem::remove(path);
+	}
+
+	void expectRejected(const std::string& fileName, uint32_t averageBytesPerSecond) {
+		const std::vector<std::byte> data{ makeData(4000) };
+		const std::filesystem::path path{
+			writeWaveFile(fileName, data, static_cast<uint32_t>(data.size()), averageBytesPerSecond)
+		};
+		bool threw{ false };
+		try {
+			WaveStreamReader reader{ path.wstring() };
+		}
+		catch (const std::runtime_error&) {
+			threw = true;
+		}
+		expect(threw, "byte rate " + std::to_string(averageBytesPerSecond) + " was accepted");
+		std::filesystem::remove(path);
+	}
+
+	//the header claims more than the file holds, ending on a partial frame
+	//a plain stream has to finish with every whole frame, a looping one has to
+	//keep going round instead of stalling on the missing data
+	void testTruncated(bool looping) {
+		const std::vector<std::byte> data{ makeData(1001) };
+		const std::size_t wholeFrameBytes{ data.size() - data.size() % blockAlign };
+		const std::filesystem::path path{ writeWaveFile("truncated.wav", data, 40000) };
+		{
+			WaveStreamReader reader{ path.wstring(), looping, 0.1, 512 };
+			reader.start();
+			std::vector<std::byte> block(400);
+			std::size_t totalRead{ 0 };
+			for (int i{ 0 }; i < 100 && !reader.isFinished(); ++i) {
+				totalRead += reader.read(block.data(), block.size());
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+			}
+			if (looping) {
+				expect(totalRead > wholeFrameBytes * 2, "truncated looping stream stalled");
+			}
+			else {
+				expect(reader.isFinished(), "truncated stream never finished");
+				expect(totalRead == wholeFrameBytes, "truncated stream lost or added data");
+			}
+		}
+		std::filesystem::remove(path);
+	}
+
+	//nothing after the header at all, looping can't help
+	void testHeaderOnly(bool looping) {
+		const std::filesystem::path path{ writeWaveFile("header_only.wav", {}, 40000) };
+		{
+			WaveStreamReader reader{ path.wstring(), looping, 0.1, 512 };
+			reader.start();
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+			expect(reader.isFinished(), "header only stream never finished");
+		}
+		std::filesystem::remove(path);
+	}
+}
+
+int main() {
+	testPlaybackSpeedConsumer();
+	expectRejected("zero_rate.wav", 0);
+	expectRejected("huge_rate.wav", 0xFFFFFFF0u);
+	testTruncated(false);
+	testTruncated(true);
+	testHeaderOnly(false);
+	testHeaderOnly(true);
+
+	if (failures > 0) {
+		std::cout << failures << " failures\n";
+		return 1;
+	}
+	std::cout << "wave stream reader ok\n";
+	return 0;
+}
\ No newline at end of file